@@ -0,0 +1,314 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file affdex_backend.cpp
+ * \brief Implementation of affdex_backend.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "affdex_backend.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace
+{
+    /**
+     * \brief The time between two sessions on the clock of a frame detector, in seconds.
+     */
+    const double SESSION_GAP = 1;
+
+    /**
+     * \brief The time on the clock of a frame detector after which it is restarted, in seconds.
+     *
+     * Up to this time, a float timestamp is precise to a quarter of a millisecond.
+     */
+    const double MAX_CLOCK = 2048;
+
+    /**
+     * \brief The number of events of the detector that can be waiting for the backend.
+     *
+     * A frame yields a few events, and the backend takes them all before handing the next frame to the detector.
+     */
+    const std::size_t EVENTS = 64;
+
+    /**
+     * \brief Wrap a frame in a frame of the SDK, sharing its pixels.
+     */
+    affdex::Frame to_affdex(const image_frame &frame)
+    {
+        const affdex::Frame::COLOR_FORMAT format = frame.format == image_frame::color_format::BGRA
+                                                   ? affdex::Frame::COLOR_FORMAT::BGRA
+                                                   : affdex::Frame::COLOR_FORMAT::BGR;
+        return affdex::Frame(frame.width, frame.height, frame.pixels, format, frame.timestamp);
+    }
+}
+
+affdex_backend::affdex_backend(std::unique_ptr<affdex::PhotoDetector> detector)
+        : m_photos(std::move(detector)), m_detector(*m_photos), m_restarting(false), m_stopping(false),
+          m_stamp(0), m_captured(-1), m_photos_stamped(0), m_spacing(0), m_clock(-SESSION_GAP),
+          m_origin(0), m_new_session(true), m_events(EVENTS)
+{
+    m_detector.setImageListener(this);
+    m_detector.setProcessStatusListener(this);
+    m_detector.start();
+    m_worker = std::thread(&affdex_backend::run, this);
+}
+
+affdex_backend::affdex_backend(std::unique_ptr<affdex::FrameDetector> detector, float frame_rate)
+        : m_frames(std::move(detector)), m_detector(*m_frames), m_restarting(false), m_stopping(false),
+          m_stamp(0), m_captured(-1), m_photos_stamped(0), m_spacing(2 / frame_rate),
+          m_clock(-SESSION_GAP), m_origin(0), m_new_session(true), m_events(EVENTS)
+{
+    m_detector.setImageListener(this);
+    m_detector.setProcessStatusListener(this);
+    m_detector.start();
+    m_worker = std::thread(&affdex_backend::run, this);
+}
+
+affdex_backend::~affdex_backend()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        fail(std::make_exception_ptr(timed_out()));
+        for (auto &waiting : m_jobs)
+        {
+            if (!waiting.reset) waiting.result.set_exception(std::make_exception_ptr(timed_out()));
+        }
+        m_jobs.clear();
+    }
+    m_changed.notify_all();
+    m_events.interrupt();
+    m_worker.join();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+    m_detector.stop();
+}
+
+std::future<analysis> affdex_backend::submit(const image_frame &frame,
+                                             std::chrono::steady_clock::time_point deadline)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(job{to_affdex(frame), deadline, std::promise<analysis>(), false});
+    std::future<analysis> result = m_jobs.back().result.get_future();
+    m_changed.notify_all();
+    return result;
+}
+
+void affdex_backend::recover()
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The frames still waiting behind a stalled one are given up as well, once late.
+    for (auto it = m_jobs.begin(); it != m_jobs.end();)
+    {
+        if (it->reset || it->deadline > now)
+        {
+            ++it;
+            continue;
+        }
+        it->result.set_exception(std::make_exception_ptr(timed_out()));
+        it = m_jobs.erase(it);
+    }
+
+    if (m_pending && m_deadline <= now)
+    {
+        // Any late result of the frame is ignored.
+        fail(std::make_exception_ptr(timed_out()));
+        m_restarting = true;
+        m_events.interrupt();
+    }
+}
+
+void affdex_backend::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(job{affdex::Frame(), std::chrono::steady_clock::time_point::max(), std::promise<analysis>(),
+                         true});
+    m_changed.notify_all();
+}
+
+std::size_t affdex_backend::events_capacity() const
+{
+    return m_events.capacity();
+}
+
+std::size_t affdex_backend::events_high_water_mark() const
+{
+    return m_events.high_water_mark();
+}
+
+void affdex_backend::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_changed.wait(lock, [this]() { return m_stopping || m_restarting || !m_jobs.empty(); });
+        if (m_stopping) return;
+
+        // The detector never waits for the backend to take its events.
+        drain();
+
+        if (m_restarting)
+        {
+            lock.unlock();
+            m_detector.stop();
+            m_detector.start();
+            lock.lock();
+            m_restarting = false;
+            continue;
+        }
+
+        job next = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        if (next.reset)
+        {
+            const bool restart = m_clock >= MAX_CLOCK;
+            lock.unlock();
+            if (restart)
+            {
+                m_detector.stop();
+                m_detector.start();
+            }
+            else
+            {
+                m_detector.reset();
+            }
+            lock.lock();
+            if (restart) m_clock = -SESSION_GAP;
+            m_new_session = true;
+            continue;
+        }
+
+        m_pending.reset(new std::promise<analysis>(std::move(next.result)));
+        m_deadline = next.deadline;
+        m_stamp = stamp(next.frame);
+        next.frame.setTimestamp(m_stamp);
+
+        // The detector may call the listeners before process() returns.
+        lock.unlock();
+        try
+        {
+            if (m_photos) m_photos->process(next.frame);
+            else m_frames->process(next.frame);
+        }
+        catch (...)
+        {
+            lock.lock();
+            fail(std::current_exception());
+            lock.unlock();
+        }
+        lock.lock();
+
+        // The results may also be reported later, by another thread of the detector.
+        while (m_pending && !m_stopping)
+        {
+            lock.unlock();
+            event reported;
+            const bool popped = m_events.pop(reported);
+            lock.lock();
+            if (popped) handle(reported);
+        }
+    }
+}
+
+void affdex_backend::drain()
+{
+    event reported;
+    while (m_events.try_pop(reported)) handle(reported);
+}
+
+void affdex_backend::handle(event &reported)
+{
+    switch (reported.type)
+    {
+        case event::CAPTURED:
+            m_captured = reported.timestamp;
+            break;
+        case event::RESULTS:
+            if (reported.timestamp == m_stamp) complete(std::move(reported.faces));
+            break;
+        case event::EXCEPTION:
+            fail(reported.error);
+            break;
+        case event::FINISHED:
+            // A frame captured without any result has no faces. The event does not tell the frame: only the last one
+            // captured can be the pending one.
+            if (m_captured == m_stamp) complete({});
+            break;
+    }
+}
+
+float affdex_backend::stamp(const affdex::Frame &frame)
+{
+    if (m_frames)
+    {
+        // The session starts after the previous one, and none of its frames is skipped.
+        if (m_new_session) m_origin = frame.getTimestamp() - (m_clock + SESSION_GAP);
+        m_new_session = false;
+        m_clock = std::max(frame.getTimestamp() - m_origin, m_clock + m_spacing);
+        return static_cast<float>(m_clock);
+    }
+
+    // A float represents exactly every integer up to 2^24.
+    m_photos_stamped = (m_photos_stamped + 1) & 0xFFFFFFu;
+    return static_cast<float>(m_photos_stamped);
+}
+
+void affdex_backend::complete(std::vector<face_record> faces)
+{
+    if (!m_pending) return;
+    m_pending->set_value(analysis{std::move(faces)});
+    m_pending.reset();
+    m_changed.notify_all();
+}
+
+void affdex_backend::fail(std::exception_ptr error)
+{
+    if (!m_pending) return;
+    m_pending->set_exception(error);
+    m_pending.reset();
+    m_changed.notify_all();
+}
+
+void affdex_backend::onImageResults(std::map<affdex::FaceId, affdex::Face> faces, affdex::Frame image)
+{
+    m_events.push(event{event::RESULTS, image.getTimestamp(), to_records(faces), nullptr});
+}
+
+void affdex_backend::onImageCapture(affdex::Frame image)
+{
+    m_events.push(event{event::CAPTURED, image.getTimestamp(), {}, nullptr});
+}
+
+void affdex_backend::onProcessingException(affdex::AffdexException ex)
+{
+    m_events.push(event{event::EXCEPTION, 0, {}, std::make_exception_ptr(ex)});
+}
+
+void affdex_backend::onProcessingFinished()
+{
+    m_events.push(event{event::FINISHED, 0, {}, nullptr});
+}
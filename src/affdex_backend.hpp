@@ -0,0 +1,270 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file affdex_backend.hpp
+ * \brief An header to analyze the images through the Affdex SDK.
+ *
+ * This header contains the backend handing each image to an Affdex detector and returning its results as a future.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_AFFDEX_BACKEND_HPP
+#define EMOTIONS_AFFDEX_BACKEND_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Frame.h>
+#include <Face.h>
+#include <FrameDetector.h>
+#include <ImageListener.h>
+#include <PhotoDetector.h>
+#include <ProcessStatusListener.h>
+
+#include "emotion_backend.hpp"
+#include "face_record.hpp"
+#include "image_frame.hpp"
+#include "spsc_ring.hpp"
+
+/**
+ * \brief A backend running an Affdex detector.
+ *
+ * This class listens to the detector: each submitted frame gets a promise, fulfilled when the detector reports the
+ * results (or the end of the processing, or an error) of that frame. Waiting on the returned future costs no CPU.
+ * The faces are converted to records as soon as they are reported, and the frame is not kept.
+ *
+ * The frames are handed to the detector by a thread of the backend, one at a time, so that a submission never waits
+ * for the detector: the deadline of a frame covers the whole analysis, including a stall of the detector inside
+ * `process()`. If the detector fails, the future holds the `affdex::AffdexException`.
+ *
+ * The listeners of the detector do not take any lock: they push the events of the detector in a bounded, lock-free
+ * ring, taken by the thread of the backend. The detector only waits if the ring is full. The detector must call its
+ * listeners from a single thread at a time.
+ *
+ * The detector only reports frames by their timestamp: each frame is handed to the detector with a timestamp of the
+ * backend, unique among the frames it is analyzing, and the results of any other frame (e.g. a late frame, given up
+ * by recover()) are ignored.
+ *
+ * A frame detector expects the timestamps to grow, and silently skips (never reporting it) any frame closer than its
+ * period to the previous one, even after `reset()`. The backend thus keeps its own clock for it: each session (the
+ * frames between two calls to reset()) starts a second after the end of the previous one, and the frames of a session
+ * keep their relative time, but are spaced by at least two periods. Since the timestamps are floats, the detector is
+ * restarted, and the clock with it, at the first session starting after about half an hour.
+ */
+class affdex_backend : public emotion_backend, private affdex::ImageListener, private affdex::ProcessStatusListener
+{
+private:
+    /**
+     * \brief A frame waiting for the detector, or a request to reset it.
+     */
+    struct job
+    {
+        affdex::Frame frame; ///< The frame, sharing its pixels with the submitted one.
+        std::chrono::steady_clock::time_point deadline; ///< The time the frame can be given up at.
+        std::promise<analysis> result; ///< The promise of the results.
+        bool reset; ///< Whether the detector must be reset instead.
+    };
+
+    /**
+     * \brief An event of the detector.
+     */
+    struct event
+    {
+        /**
+         * \brief The kind of an event.
+         */
+        enum kind
+        {
+            CAPTURED, ///< A frame has been captured (`onImageCapture`).
+            RESULTS, ///< The results of a frame are available (`onImageResults`).
+            EXCEPTION, ///< The detector failed (`onProcessingException`).
+            FINISHED ///< The processing is finished (`onProcessingFinished`).
+        };
+
+        kind type; ///< The kind of the event.
+        float timestamp; ///< The timestamp of the frame, if any.
+        std::vector<face_record> faces; ///< The faces found in the frame, if any.
+        std::exception_ptr error; ///< The exception of the detector, if any.
+    };
+
+    std::unique_ptr<affdex::PhotoDetector> m_photos;
+    std::unique_ptr<affdex::FrameDetector> m_frames;
+    affdex::Detector &m_detector;
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<job> m_jobs;
+    std::unique_ptr<std::promise<analysis>> m_pending;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_restarting;
+    bool m_stopping;
+    float m_stamp;
+    float m_captured;
+    std::uint32_t m_photos_stamped;
+    const double m_spacing;
+    double m_clock;
+    double m_origin;
+    bool m_new_session;
+    spsc_ring<event> m_events;
+    std::thread m_worker;
+
+    /**
+     * \brief Hand the submitted frames to the detector.
+     *
+     * This function runs on the thread of the backend until it is destroyed. After a frame is given up, the detector
+     * is restarted as soon as it returns from `process()`.
+     */
+    void run();
+
+    /**
+     * \brief Choose the timestamp a frame is handed to the detector with.
+     *
+     * A photo detector does not use the timestamps: the photos are simply numbered. A frame detector needs the time
+     * of the frames to track the faces: the frame gets the time of the clock of the backend (see affdex_backend).
+     *
+     * This function must be called while holding `m_mutex`.
+     *
+     * \param frame The frame.
+     * \return The timestamp of the frame for the detector.
+     */
+    float stamp(const affdex::Frame &frame);
+
+    /**
+     * \brief Handle the events the detector has already reported.
+     *
+     * This function must be called while holding `m_mutex`.
+     */
+    void drain();
+
+    /**
+     * \brief Handle an event of the detector.
+     *
+     * The results of any frame other than the pending one are ignored.
+     *
+     * This function must be called while holding `m_mutex`.
+     *
+     * \param reported The event.
+     */
+    void handle(event &reported);
+
+    /**
+     * \brief Fulfill the pending promise, if any.
+     *
+     * This function must be called while holding `m_mutex`.
+     *
+     * \param faces The faces found in the image.
+     */
+    void complete(std::vector<face_record> faces);
+
+    /**
+     * \brief Fail the pending promise, if any.
+     *
+     * This function must be called while holding `m_mutex`.
+     *
+     * \param error The exception of the failure.
+     */
+    void fail(std::exception_ptr error);
+
+    void onImageResults(std::map<affdex::FaceId, affdex::Face> faces, affdex::Frame image) override;
+
+    void onImageCapture(affdex::Frame image) override;
+
+    void onProcessingException(affdex::AffdexException ex) override;
+
+    void onProcessingFinished() override;
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * This constructor registers the backend as the image and process status listener of the detector, and starts
+     * it.
+     *
+     * \param detector The detector, configured but not started yet.
+     */
+    explicit affdex_backend(std::unique_ptr<affdex::PhotoDetector> detector);
+
+    /**
+     * \brief Construct a backend analyzing a sequence of frames.
+     *
+     * This constructor registers the backend as the image and process status listener of the detector, and starts
+     * it.
+     *
+     * \param detector The detector, configured but not started yet.
+     * \param frame_rate The number of frames per second processed by the detector.
+     */
+    affdex_backend(std::unique_ptr<affdex::FrameDetector> detector, float frame_rate);
+
+    /**
+     * \brief The class destructor.
+     *
+     * This destructor gives up the frames not analyzed yet, waits for the detector to return from `process()` and
+     * stops it.
+     */
+    ~affdex_backend() override;
+
+    std::future<analysis> submit(const image_frame &frame, std::chrono::steady_clock::time_point deadline) override;
+
+    /**
+     * \brief Give up the frames past their deadline.
+     *
+     * If the frame being analyzed is given up, the detector is restarted, so that a stalled detector can analyze the
+     * next frames. The state of the detector (e.g. the tracked faces) is lost. A detector that never returns from
+     * `process()` cannot be restarted: the following frames are given up as well, once past their deadline.
+     */
+    void recover() override;
+
+    /**
+     * \brief Forget the faces tracked in the previous frames.
+     *
+     * The detector is reset once the frames submitted before are done, and the following frames belong to a new
+     * session.
+     */
+    void reset() override;
+
+    /**
+     * \brief Get the maximum number of events of the detector that can be waiting for the backend.
+     *
+     * \return The capacity of the ring of the events.
+     */
+    std::size_t events_capacity() const;
+
+    /**
+     * \brief Get the maximum number of events of the detector that have been waiting for the backend at the same time.
+     *
+     * If it reaches events_capacity(), the detector has waited for the backend to take its events.
+     *
+     * \return The high-water mark of the ring of the events.
+     */
+    std::size_t events_high_water_mark() const;
+};
+
+#endif //EMOTIONS_AFFDEX_BACKEND_HPP
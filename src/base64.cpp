@@ -4,7 +4,7 @@
 
    base64 encoding and decoding with C++.
 
-   \version 1.01.00
+   \version 1.02.00
 
    \copyright Copyright (C) 2004-2017 René Nyffenegger<br>
    This source code is provided 'as-is', without any express or implied
@@ -28,16 +28,277 @@
 */
 
 #include "base64.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BASE64_X86_KERNELS
+#include <immintrin.h>
+#endif
+
 static const std::string base64_chars =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
         "abcdefghijklmnopqrstuvwxyz"
         "0123456789+/";
 
+namespace
+{
+    const unsigned char INVALID_SYMBOL = 0xff; ///< Marks a byte that ends the encoded data.
+    const unsigned char SPACE_SYMBOL = 0xfe; ///< Marks a byte that is skipped while decoding.
+
+    /**
+     * \brief The 256-entry table mapping every byte to its 6-bit value.
+     *
+     * Bytes outside the alphabet map to INVALID_SYMBOL, whitespace (which
+     * includes the MIME line breaks) maps to SPACE_SYMBOL.
+     */
+    struct decode_table
+    {
+        unsigned char values[256];
+
+        decode_table()
+        {
+            std::fill(values, values + 256, INVALID_SYMBOL);
+            for (std::size_t i = 0; i < base64_chars.size(); i++)
+                values[static_cast<unsigned char>(base64_chars[i])] = static_cast<unsigned char>(i);
+            for (unsigned char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+                values[c] = SPACE_SYMBOL;
+        }
+    };
+
+    const decode_table DECODE_TABLE;
+
+    /**
+     * \brief Write the three bytes packed in four 6-bit values.
+     */
+    inline void write_quad(const unsigned char *quad, unsigned char *out)
+    {
+        out[0] = static_cast<unsigned char>((quad[0] << 2) + ((quad[1] & 0x30) >> 4));
+        out[1] = static_cast<unsigned char>(((quad[1] & 0xf) << 4) + ((quad[2] & 0x3c) >> 2));
+        out[2] = static_cast<unsigned char>(((quad[2] & 0x3) << 6) + quad[3]);
+    }
+
+    /**
+     * \brief A function decoding whole blocks of symbols.
+     *
+     * A block decoder consumes complete quads from `s` as long as they only
+     * contain alphabet symbols. It stops, leaving `s` on the first block it
+     * could not handle, as soon as it meets anything else (padding,
+     * whitespace, invalid bytes or the end of the input).
+     *
+     * \return The number of bytes written to `out`.
+     */
+    typedef std::size_t (*block_decoder)(const unsigned char *&s, const unsigned char *end, unsigned char *out);
+
+    std::size_t decode_blocks_scalar(const unsigned char *&s, const unsigned char *end, unsigned char *out)
+    {
+        unsigned char *o = out;
+        while (end - s >= 4)
+        {
+            const unsigned char quad[4] = {DECODE_TABLE.values[s[0]], DECODE_TABLE.values[s[1]],
+                                           DECODE_TABLE.values[s[2]], DECODE_TABLE.values[s[3]]};
+            if ((quad[0] | quad[1] | quad[2] | quad[3]) & 0xc0) break;
+
+            write_quad(quad, o);
+            s += 4;
+            o += 3;
+        }
+        return o - out;
+    }
+
+#ifdef BASE64_X86_KERNELS
+    // The vector kernels follow Wojciech Muła's and Alfred Klomp's
+    // "nibble lookup" decoder: the two nibbles of each byte index two tables
+    // whose AND is non-zero only for bytes outside the alphabet, and a third
+    // table gives the offset turning an ASCII symbol into its 6-bit value.
+
+    __attribute__((target("sse4.1")))
+    std::size_t decode_blocks_sse41(const unsigned char *&s, const unsigned char *end, unsigned char *out)
+    {
+        const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                             0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+        const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                             0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i mask_2f = _mm_set1_epi8(0x2f);
+
+        unsigned char *o = out;
+        while (end - s >= 16)
+        {
+            __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+
+            const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask_2f);
+            const __m128i lo_nibbles = _mm_and_si128(str, mask_2f);
+            const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+            const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+            if (!_mm_testz_si128(lo, hi)) break;
+
+            const __m128i eq_2f = _mm_cmpeq_epi8(str, mask_2f);
+            const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+            str = _mm_add_epi8(str, roll);
+
+            // Pack the four 6-bit values of each dword into three bytes.
+            const __m128i merged = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+            const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+            const __m128i bytes = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                                                         -1, -1, -1, -1));
 
-static inline bool is_base64(unsigned char c) {
-    return (isalnum(c) || (c == '+') || (c == '/'));
+            alignas(16) unsigned char block[16];
+            _mm_store_si128(reinterpret_cast<__m128i *>(block), bytes);
+            std::memcpy(o, block, 12);
+            s += 16;
+            o += 12;
+        }
+        return (o - out) + decode_blocks_scalar(s, end, o);
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t decode_blocks_avx2(const unsigned char *&s, const unsigned char *end, unsigned char *out)
+    {
+        const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+                                                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+        const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                  0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+
+        unsigned char *o = out;
+        while (end - s >= 32)
+        {
+            __m256i str = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+
+            const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2f);
+            const __m256i lo_nibbles = _mm256_and_si256(str, mask_2f);
+            const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+            const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+            if (!_mm256_testz_si256(lo, hi)) break;
+
+            const __m256i eq_2f = _mm256_cmpeq_epi8(str, mask_2f);
+            const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+            str = _mm256_add_epi8(str, roll);
+
+            // Same packing as the SSE kernel, then move the 12 bytes of the
+            // upper lane next to the ones of the lower lane.
+            const __m256i merged = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+            const __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+            const __m256i bytes = _mm256_shuffle_epi8(packed, _mm256_setr_epi8(
+                    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            const __m256i compact = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+
+            alignas(32) unsigned char block[32];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(block), compact);
+            std::memcpy(o, block, 24);
+            s += 32;
+            o += 24;
+        }
+        return (o - out) + decode_blocks_sse41(s, end, o);
+    }
+#endif
+
+    /**
+     * \brief Check if the running CPU supports a block decoder.
+     */
+    bool supports(base64::kernel k)
+    {
+#ifdef BASE64_X86_KERNELS
+        __builtin_cpu_init();
+        if (k == base64::kernel::avx2) return __builtin_cpu_supports("avx2");
+        if (k == base64::kernel::sse41) return __builtin_cpu_supports("sse4.1");
+#endif
+        return k == base64::kernel::scalar;
+    }
+
+    /**
+     * \brief Get the block decoder of an implementation the CPU supports.
+     */
+    block_decoder block_decoder_of(base64::kernel k)
+    {
+#ifdef BASE64_X86_KERNELS
+        if (k == base64::kernel::avx2) return decode_blocks_avx2;
+        if (k == base64::kernel::sse41) return decode_blocks_sse41;
+#endif
+        return decode_blocks_scalar;
+    }
+
+    /**
+     * \brief Pick the fastest block decoder supported by the running CPU.
+     */
+    base64::kernel select_kernel()
+    {
+        if (supports(base64::kernel::avx2)) return base64::kernel::avx2;
+        if (supports(base64::kernel::sse41)) return base64::kernel::sse41;
+        return base64::kernel::scalar;
+    }
+
+    base64::kernel active = select_kernel();
+    block_decoder decode_blocks = block_decoder_of(active);
+
+    /**
+     * \brief Decode a run of base64 symbols.
+     *
+     * Whole blocks go through the selected vector kernel; whatever the kernel
+     * refuses (whitespace, a trailing partial quad, the end of the data) is
+     * handled one symbol at a time before handing control back to it. The
+     * symbols of an incomplete quad are left in `quad`/`size` for the next
+     * call, and `ended` is set once the end of the data is found.
+     *
+     * \return The number of bytes written to `out`.
+     */
+    std::size_t decode_symbols(const unsigned char *s, const unsigned char *end, unsigned char *out,
+                               unsigned char *quad, int &size, bool &ended)
+    {
+        const std::ptrdiff_t SCALAR_STRETCH = 32;
+
+        unsigned char *o = out;
+        while (s < end)
+        {
+            if (size == 0) o += decode_blocks(s, end, o);
+
+            const unsigned char *stop = s + std::min(SCALAR_STRETCH, end - s);
+            for (; s < stop; s++)
+            {
+                const unsigned char value = DECODE_TABLE.values[*s];
+                if (value == SPACE_SYMBOL) continue;
+                if (value == INVALID_SYMBOL)
+                {
+                    ended = true;
+                    return o - out;
+                }
+
+                quad[size++] = value;
+                if (size == 4)
+                {
+                    write_quad(quad, o);
+                    o += 3;
+                    size = 0;
+                }
+            }
+        }
+        return o - out;
+    }
+
+    /**
+     * \brief Decode the symbols of an incomplete quad.
+     *
+     * \return The number of bytes written to `out` (at most 2).
+     */
+    std::size_t decode_leftover(unsigned char *quad, int size, unsigned char *out)
+    {
+        if (size < 2) return 0;
+
+        unsigned char bytes[3];
+        std::fill(quad + size, quad + 4, 0);
+        write_quad(quad, bytes);
+        std::copy(bytes, bytes + size - 1, out);
+        return size - 1;
+    }
 }
 
 std::string base64::encode(const std::string &s)
@@ -87,39 +348,76 @@ std::string base64::encode(unsigned char const* bytes_to_encode, unsigned int in
 
 }
 
-std::string base64::decode(std::string const& encoded_string) {
-    int in_len = encoded_string.size();
-    int i = 0;
-    int j = 0;
-    int in_ = 0;
-    unsigned char char_array_4[4], char_array_3[3];
-    std::string ret = "";
-
-    while (in_len-- && ( encoded_string[in_] != '=') && is_base64(encoded_string[in_])) {
-        char_array_4[i++] = encoded_string[in_]; in_++;
-        if (i ==4) {
-            for (i = 0; i <4; i++)
-                char_array_4[i] = base64_chars.find(char_array_4[i]);
+std::string base64::decode(std::string const &encoded_string)
+{
+    std::string ret(decoded_size(encoded_string.data(), encoded_string.size()), '\0');
+    ret.resize(decode(encoded_string.data(), encoded_string.size(), reinterpret_cast<unsigned char *>(&ret[0])));
+    return ret;
+}
 
-            char_array_3[0] = ( char_array_4[0] << 2       ) + ((char_array_4[1] & 0x30) >> 4);
-            char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-            char_array_3[2] = ((char_array_4[2] & 0x3) << 6) +   char_array_4[3];
+std::size_t base64::decoded_size(const char *s, std::size_t len)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(s);
+    while (len > 0 && DECODE_TABLE.values[bytes[len - 1]] == SPACE_SYMBOL) len--;
 
-            for (i = 0; (i < 3); i++)
-                ret += char_array_3[i];
-            i = 0;
-        }
+    std::size_t padding = 0;
+    while (padding < 2 && len > 0 && s[len - 1] == '=')
+    {
+        len--;
+        padding++;
     }
 
-    if (i) {
-        for (j = 0; j < i; j++)
-            char_array_4[j] = base64_chars.find(char_array_4[j]);
+    return len / 4 * 3 + (len % 4 > 1 ? len % 4 - 1 : 0);
+}
 
-        char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-        char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
+std::size_t base64::decode(const char *s, std::size_t len, unsigned char *out)
+{
+    decoder d;
+    const std::size_t written = d.update(s, len, out);
+    return written + d.finish(out + written);
+}
 
-        for (j = 0; (j < i - 1); j++) ret += char_array_3[j];
-    }
+base64::kernel base64::active_kernel()
+{
+    return active;
+}
 
-    return ret;
+bool base64::use_kernel(kernel k)
+{
+    if (!supports(k)) return false;
+
+    active = k;
+    decode_blocks = block_decoder_of(k);
+    return true;
+}
+
+base64::decoder::decoder()
+        : m_size(0), m_ended(false)
+{
+}
+
+std::size_t base64::decoder::max_decoded_size(std::size_t len)
+{
+    return (len + 3) / 4 * 3;
+}
+
+std::size_t base64::decoder::update(const char *s, std::size_t len, unsigned char *out)
+{
+    if (m_ended) return 0;
+
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(s);
+    return decode_symbols(bytes, bytes + len, out, m_quad, m_size, m_ended);
+}
+
+std::size_t base64::decoder::finish(unsigned char *out)
+{
+    const std::size_t written = decode_leftover(m_quad, m_size, out);
+    m_size = 0;
+    m_ended = true;
+    return written;
+}
+
+bool base64::decoder::ended() const
+{
+    return m_ended;
 }
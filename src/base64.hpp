@@ -1,7 +1,7 @@
 /**
  * \file base64.hpp
  * \brief Encode and decode base64 string.
- * \version 1.01.00
+ * \version 1.02.00
  * \authors [René Nyffenegger](https://renenyffenegger.ch/notes/development/Base64/Encoding-and-decoding-base-64-with-cpp),
  * modified and documented by Andrea Esposito.
  */
@@ -9,6 +9,7 @@
 #ifndef BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A
 #define BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A
 
+#include <cstddef>
 #include <string>
 
 /**
@@ -42,11 +43,138 @@ namespace base64
     /**
      * \brief Decode a base64 string.
      *
-     * This function decodes a base64 string to a binary string.
+     * This function decodes a base64 string to a binary string. Whitespace
+     * (including MIME line breaks) is skipped, while the padding or any other
+     * byte outside the base64 alphabet marks the end of the encoded data.
+     *
+     * Whole blocks of symbols are decoded with AVX2 or SSE4.1 when the CPU
+     * supports them (checked once, at startup), falling back to a lookup
+     * table otherwise.
      *
      * \param s The string to be decoded.
      * \return The decoded string.
      */
     std::string decode(std::string const &s);
+
+    /**
+     * \brief Compute the size of a decoded base64 buffer.
+     *
+     * This function computes, from its length and its padding, the number of
+     * bytes a base64 buffer decodes to. Trailing whitespace is ignored; if the
+     * buffer contains embedded whitespace the result is an upper bound.
+     *
+     * \param s The buffer to be decoded.
+     * \param len The length of the buffer `s`.
+     * \return The size of the buffer needed by decode(const char *, std::size_t, unsigned char *).
+     */
+    std::size_t decoded_size(const char *s, std::size_t len);
+
+    /**
+     * \brief Decode a base64 buffer into a caller-supplied buffer.
+     *
+     * This function decodes a base64 buffer exactly as decode(const std::string &)
+     * does, writing the result to `out` instead of allocating a string.
+     *
+     * \param s The buffer to be decoded.
+     * \param len The length of the buffer `s`.
+     * \param out The output buffer, at least decoded_size(s, len) bytes long.
+     * \return The number of bytes written to `out`.
+     */
+    std::size_t decode(const char *s, std::size_t len, unsigned char *out);
+
+    /**
+     * \brief The implementations decoding whole blocks of symbols.
+     */
+    enum class kernel
+    {
+        scalar, ///< The lookup table, always available.
+        sse41, ///< The SSE4.1 kernel.
+        avx2 ///< The AVX2 kernel.
+    };
+
+    /**
+     * \brief Get the implementation decoding whole blocks of symbols.
+     *
+     * \return The implementation in use: the fastest one supported by the
+     * CPU, unless another one has been chosen through use_kernel().
+     */
+    kernel active_kernel();
+
+    /**
+     * \brief Choose the implementation decoding whole blocks of symbols.
+     *
+     * Every implementation yields the same results: this function is only
+     * meant for tests and benchmarks, and must not be called while any
+     * thread is decoding.
+     *
+     * \param k The implementation.
+     * \return True if the CPU supports the implementation, which is then used
+     * by the following decodings, false otherwise.
+     */
+    bool use_kernel(kernel k);
+
+    /**
+     * \brief An incremental base64 decoder.
+     *
+     * This class decodes a base64 stream given in chunks of arbitrary size,
+     * emitting the decoded bytes as soon as they are available. The 0 to 3
+     * symbols that do not complete a quad are kept between calls, so the
+     * concatenation of the outputs equals decode(const std::string &) applied
+     * to the concatenation of the inputs.
+     */
+    class decoder
+    {
+    private:
+        unsigned char m_quad[4];
+        int m_size;
+        bool m_ended;
+
+    public:
+        /**
+         * \brief The class constructor.
+         *
+         * This constructor creates a decoder waiting for the first chunk.
+         */
+        decoder();
+
+        /**
+         * \brief Compute the output space needed by a chunk.
+         *
+         * \param len The length of the chunk.
+         * \return The number of bytes update() may write for a chunk of `len` bytes.
+         */
+        static std::size_t max_decoded_size(std::size_t len);
+
+        /**
+         * \brief Decode a chunk.
+         *
+         * This function decodes a chunk, together with the symbols left over by
+         * the previous one. Once the end of the data is found (the padding or a
+         * byte outside the alphabet) the rest of the stream is ignored.
+         *
+         * \param s The chunk to be decoded.
+         * \param len The length of the chunk `s`.
+         * \param out The output buffer, at least max_decoded_size(len) bytes long.
+         * \return The number of bytes written to `out`.
+         */
+        std::size_t update(const char *s, std::size_t len, unsigned char *out);
+
+        /**
+         * \brief Terminate the stream.
+         *
+         * This function decodes the symbols of a trailing incomplete quad.
+         *
+         * \param out The output buffer, at least 2 bytes long.
+         * \return The number of bytes written to `out`.
+         */
+        std::size_t finish(unsigned char *out);
+
+        /**
+         * \brief Check if the end of the data has been found.
+         *
+         * \return True if no further input will be decoded, false otherwise.
+         */
+        bool ended() const;
+    };
 }
 #endif /* BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A */
\ No newline at end of file
@@ -0,0 +1,50 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file classifiers.cpp
+ * \brief Implementation of classifiers.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "classifiers.hpp"
+
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+classifier_set classifier_set::parse(const std::string &list)
+{
+    classifier_set groups;
+    groups.emotions = groups.expressions = groups.emojis = groups.appearances = false;
+
+    std::vector<std::string> names;
+    boost::split(names, list, boost::is_any_of(","));
+    for (auto &name : names)
+    {
+        boost::trim(name);
+        if (name == "emotions") groups.emotions = true;
+        else if (name == "expressions") groups.expressions = true;
+        else if (name == "emojis") groups.emojis = true;
+        else if (name == "appearances") groups.appearances = true;
+        else throw std::invalid_argument("Unknown classifier group '" + name + "'");
+    }
+    return groups;
+}
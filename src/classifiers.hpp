@@ -0,0 +1,59 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file classifiers.hpp
+ * \brief An header to select the classifiers of the detector.
+ *
+ * This header contains the groups of classifiers that can be enabled in the detector (and written in the results).
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_CLASSIFIERS_HPP
+#define EMOTIONS_CLASSIFIERS_HPP
+
+#include <stdexcept>
+#include <string>
+
+/**
+ * \brief The groups of classifiers to be enabled.
+ *
+ * Each enabled group is run by the detector and written in the results; the other ones are neither computed nor
+ * written.
+ */
+struct classifier_set
+{
+    bool emotions = true; ///< The emotions, including the valence and the engagement.
+    bool expressions = true; ///< The facial expressions.
+    bool emojis = true; ///< The emojis, including the dominant one.
+    bool appearances = true; ///< The appearance (glasses, age, ethnicity and gender).
+
+    /**
+     * \brief Parse a list of groups.
+     *
+     * \param list The names of the groups (`emotions`, `expressions`, `emojis` or `appearances`), separated by commas.
+     * \return The set containing only the listed groups.
+     *
+     * \throws std::invalid_argument if a name is not a group.
+     */
+    static classifier_set parse(const std::string &list);
+};
+
+#endif //EMOTIONS_CLASSIFIERS_HPP
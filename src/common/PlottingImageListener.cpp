@@ -13,23 +13,104 @@
 #include <boost/filesystem.hpp>
 #include <boost/timer/timer.hpp>
 
+#include <array>
+#include <utility>
+
+#include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 
 #include <rapidjson/writer.h>
+
+#ifdef EMOTIONS_WITH_AFFDEX
 #include "Visualizer.h"
 
 #include "ImageListener.h"
 
 using namespace affdex;
+#endif
+
+namespace
+{
+    typedef rapidjson::Value::StringRefType Key;
+
+    template <std::size_t N, std::size_t... I>
+    std::array <Key, N> makeKeys(const char *const (&names)[N], std::index_sequence<I...>)
+    {
+        return {{rapidjson::StringRef(names[I])...}};
+    }
+
+    /**
+     * The keys of a group of values, built once from the names listed by
+     * face_record.
+     */
+    template <std::size_t N>
+    std::array <Key, N> makeKeys(const char *const (&names)[N])
+    {
+        return makeKeys(names, std::make_index_sequence<N>());
+    }
+
+    const std::array <Key, face_record::EMOTIONS> EMOTION_KEYS = makeKeys(face_record::EMOTION_NAMES);
+    const std::array <Key, face_record::EXPRESSIONS> EXPRESSION_KEYS = makeKeys(face_record::EXPRESSION_NAMES);
+    const std::array <Key, face_record::EMOJIS> EMOJI_KEYS = makeKeys(face_record::EMOJI_NAMES);
+    const std::array <Key, face_record::HEAD_ANGLES> HEAD_ANGLE_KEYS = makeKeys(face_record::HEAD_ANGLE_NAMES);
+
+    const Key FACE_ID = rapidjson::StringRef("faceId");
+    const Key DOMINANT_EMOJI = rapidjson::StringRef("dominantEmoji");
+    const Key MEASUREMENTS = rapidjson::StringRef("measurements");
+    const Key INTEROCULAR_DISTANCE = rapidjson::StringRef("interocularDistance");
+    const Key ORIENTATION = rapidjson::StringRef("orientation");
+    const Key APPEARANCE = rapidjson::StringRef("appearance");
+    const Key GLASSES = rapidjson::StringRef("glasses");
+    const Key AGE = rapidjson::StringRef("age");
+    const Key ETHNICITY = rapidjson::StringRef("ethnicity");
+    const Key GENDER = rapidjson::StringRef("gender");
+    const Key EMOTIONS = rapidjson::StringRef("emotions");
+    const Key EXPRESSIONS = rapidjson::StringRef("expressions");
+    const Key EMOJIS = rapidjson::StringRef("emojis");
+    const Key SESSION = rapidjson::StringRef("session");
+    const Key TIMESTAMP = rapidjson::StringRef("timestamp");
+    const Key ERROR_MESSAGE = rapidjson::StringRef("error");
+
+    void writeKey(result_writer::json_writer &writer, const Key &key)
+    {
+        writer.Key(key.s, key.length);
+    }
+
+    template <std::size_t N>
+    void writeFeatures(result_writer::json_writer &writer, const std::array<float, N> &features,
+                       const std::array <Key, N> &keys)
+    {
+        writer.StartObject();
+        for (std::size_t i = 0; i < N; i++)
+        {
+            writeKey(writer, keys[i]);
+            writer.Double(features[i]);
+        }
+        writer.EndObject();
+    }
+
+    /**
+     * The buffer formatting the single results: each thread reuses its own.
+     */
+    rapidjson::StringBuffer &formatBuffer()
+    {
+        thread_local rapidjson::StringBuffer buffer;
+        buffer.Clear();
+        return buffer;
+    }
+
+}
 
 PlottingImageListener::PlottingImageListener()
-        : mStartT(std::chrono::system_clock::now()),
-          mCaptureLastTS(-1.0f), mCaptureFPS(-1.0f),
-          mProcessLastTS(-1.0f), mProcessFPS(-1.0f)
+        : mCaptureLastTS(-1.0f), mCaptureFPS(-1.0f),
+          mProcessLastTS(-1.0f), mProcessFPS(-1.0f),
+          mStartT(std::chrono::system_clock::now()),
+          mResults(mResultBuffer)
 {
-    document.SetArray();
+    mResults.StartArray();
 }
 
+#ifdef EMOTIONS_WITH_AFFDEX
 cv::Point2f PlottingImageListener::minPoint(VecFeaturePoint points)
 {
     VecFeaturePoint::iterator it = points.begin();
@@ -53,6 +134,7 @@ cv::Point2f PlottingImageListener::maxPoint(VecFeaturePoint points)
     }
     return cv::Point2f(ret.x, ret.y);
 }
+#endif
 
 double PlottingImageListener::getProcessingFrameRate()
 {
@@ -66,25 +148,10 @@ double PlottingImageListener::getCaptureFrameRate()
     return mCaptureFPS;
 }
 
-int PlottingImageListener::getDataSize()
-{
-    std::lock_guard <std::mutex> lg(mMutex);
-    return mDataArray.size();
-
-}
-
-std::pair <Frame, std::map<FaceId, Face>> PlottingImageListener::getData()
+#ifdef EMOTIONS_WITH_AFFDEX
+void PlottingImageListener::onImageResults(std::map <FaceId, Face>, Frame)
 {
     std::lock_guard <std::mutex> lg(mMutex);
-    std::pair <Frame, std::map<FaceId, Face>> dpoint = mDataArray.front();
-    mDataArray.pop_front();
-    return dpoint;
-}
-
-void PlottingImageListener::onImageResults(std::map <FaceId, Face> faces, Frame image)
-{
-    std::lock_guard <std::mutex> lg(mMutex);
-    mDataArray.push_back(std::pair < Frame, std::map < FaceId, Face >> (image, faces));
     std::chrono::time_point <std::chrono::system_clock> now = std::chrono::system_clock::now();
     std::chrono::milliseconds milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now - mStartT);
     double seconds = milliseconds.count() / 1000.f;
@@ -98,25 +165,61 @@ void PlottingImageListener::onImageCapture(Frame image)
     mCaptureFPS = 1.0f / (image.getTimestamp() - mCaptureLastTS);
     mCaptureLastTS = image.getTimestamp();
 }
+#endif
 
-rapidjson::Value
-PlottingImageListener::printFeatures(rapidjson::Document &document, float *features,
-                                     const std::vector <std::string> &viz)
+void PlottingImageListener::writeFace(result_writer::json_writer &writer, const face_record &f) const
 {
-    rapidjson::Value temp;
-    temp.SetObject();
-    for (const std::string &property : viz)
+    writeKey(writer, FACE_ID);
+    writer.Int(f.id);
+    if (mClassifiers.emojis)
+    {
+        const std::string &dominantEmoji = face_record::emoji_name(f.dominant_emoji);
+        writeKey(writer, DOMINANT_EMOJI);
+        writer.String(dominantEmoji.c_str(), dominantEmoji.size());
+    }
+
+    writeKey(writer, MEASUREMENTS);
+    writer.StartObject();
+    writeKey(writer, INTEROCULAR_DISTANCE);
+    writer.Double(f.interocular_distance);
+    writeKey(writer, ORIENTATION);
+    writeFeatures(writer, f.orientation, HEAD_ANGLE_KEYS);
+    writer.EndObject();
+
+    if (mClassifiers.appearances)
+    {
+        writeKey(writer, APPEARANCE);
+        writer.StartObject();
+        writeKey(writer, GLASSES);
+        writer.Bool(f.glasses);
+        writeKey(writer, AGE);
+        writer.String(face_record::AGE_NAMES[static_cast<std::size_t>(f.age)]);
+        writeKey(writer, ETHNICITY);
+        writer.String(face_record::ETHNICITY_NAMES[static_cast<std::size_t>(f.ethnicity)]);
+        writeKey(writer, GENDER);
+        writer.String(face_record::GENDER_NAMES[static_cast<std::size_t>(f.gender)]);
+        writer.EndObject();
+    }
+
+    if (mClassifiers.emotions)
+    {
+        writeKey(writer, EMOTIONS);
+        writeFeatures(writer, f.emotions, EMOTION_KEYS);
+    }
+    if (mClassifiers.expressions)
+    {
+        writeKey(writer, EXPRESSIONS);
+        writeFeatures(writer, f.expressions, EXPRESSION_KEYS);
+    }
+    if (mClassifiers.emojis)
     {
-        temp.AddMember(rapidjson::Value().SetString(property.c_str(), property.size()), rapidjson::Value(*features).Move(), document.GetAllocator());
-        features++;
+        writeKey(writer, EMOJIS);
+        writeFeatures(writer, f.emojis, EMOJI_KEYS);
     }
-    return temp;
 }
 
-void PlottingImageListener::addResult(const std::map <FaceId, Face> &faces, const double timeStamp)
+void PlottingImageListener::writeResult(result_writer::json_writer &writer, const std::vector <face_record> &faces) const
 {
-    rapidjson::Value v;
-    v.SetObject();
     // if (faces.empty())
     // {
     //     fStream << timeStamp << ",nan,nan,no,unknown,unknown,unknown,unknown,";
@@ -126,53 +229,113 @@ void PlottingImageListener::addResult(const std::map <FaceId, Face> &faces, cons
     //     for (std::string emoji : viz.EMOJIS) fStream << "nan,";
     //     fStream << std::endl;
     // }
-    auto &allocator = document.GetAllocator();
-    // NOTE: To save all faces, decomment this 'for' (and comment the 'if') and
-    // change the definition of f (see the comment), alongside with the
-    // structure of the JSON 
-    //
-    // for (auto &face_id_pair : faces)
-    if (!faces.empty())
-    {
-        Face f = faces.begin()->second; // To save all faces, change 'faces.begin()->' to 'face_id_pair.'
-
-        v.AddMember("faceId", rapidjson::Value(f.id).Move(), allocator);
-        const std::string dominantEmoji = affdex::EmojiToString(f.emojis.dominantEmoji);
-        v.AddMember("dominantEmoji", rapidjson::Value().SetString(dominantEmoji.c_str(), dominantEmoji.size()), allocator);
-
-        rapidjson::Value measurements;
-        measurements.SetObject();
-        measurements.AddMember("interocularDistance", rapidjson::Value(f.measurements.interocularDistance).Move(), allocator);
-        measurements.AddMember("orientation", printFeatures(document, (float *) &f.measurements.orientation, viz.HEAD_ANGLES), allocator);
-        v.AddMember("measurements", measurements,allocator);
-
-        rapidjson::Value appearance;
-        appearance.SetObject();
-        appearance.AddMember("glasses", rapidjson::Value(viz.GLASSES_MAP[f.appearance.glasses]).Move(), allocator);
-        appearance.AddMember("age", rapidjson::Value().SetString(viz.AGE_MAP[f.appearance.age].c_str(), viz.AGE_MAP[f.appearance.age].size()), allocator);
-        appearance.AddMember("ethnicity", rapidjson::Value().SetString(viz.ETHNICITY_MAP[f.appearance.ethnicity].c_str(), viz.ETHNICITY_MAP[f.appearance.ethnicity].size()), allocator);
-        appearance.AddMember("gender", rapidjson::Value().SetString(viz.GENDER_MAP[f.appearance.gender].c_str(), viz.GENDER_MAP[f.appearance.gender].size()), allocator);
-        v.AddMember("appearance", appearance, allocator);
-
-        rapidjson::Value emotions = printFeatures(document, (float *) &f.emotions, viz.EMOTIONS);
-        v.AddMember("emotions", emotions, allocator);
-        rapidjson::Value expressions = printFeatures(document, (float *) &f.emotions, viz.EXPRESSIONS);
-        v.AddMember("expressions", expressions, allocator);
-        rapidjson::Value emojis = printFeatures(document, (float *) &f.emojis, viz.EMOJIS);
-        v.AddMember("emojis", emojis, allocator);
-    }
-    document.PushBack(v, allocator);
+
+    // NOTE: To save all faces, write each face (instead of the first one) as
+    // an object of an array, changing the structure of the JSON accordingly.
+    if (!faces.empty()) writeFace(writer, faces.front());
+}
+
+result_writer::json_writer &PlottingImageListener::beginResult()
+{
+    return mWriter ? mWriter->begin() : mResults;
+}
+
+void PlottingImageListener::endResult()
+{
+    if (mWriter) mWriter->end();
+}
+
+void PlottingImageListener::addResult(const std::vector <face_record> &faces)
+{
+    result_writer::json_writer &writer = beginResult();
+    writer.StartObject();
+    writeResult(writer, faces);
+    writer.EndObject();
+    endResult();
+}
+
+void PlottingImageListener::addResult(const std::string &session, const std::vector <face_record> &faces,
+                                      const double timeStamp)
+{
+    result_writer::json_writer &writer = beginResult();
+    writer.StartObject();
+    writeResult(writer, faces);
+    writeKey(writer, SESSION);
+    writer.String(session.c_str(), session.size());
+    writeKey(writer, TIMESTAMP);
+    writer.Double(timeStamp);
+    writer.EndObject();
+    endResult();
+}
+
+void PlottingImageListener::addError(const std::string &error)
+{
+    result_writer::json_writer &writer = beginResult();
+    writer.StartObject();
+    writeKey(writer, ERROR_MESSAGE);
+    writer.String(error.c_str(), error.size());
+    writer.EndObject();
+    endResult();
+}
+
+void PlottingImageListener::addError(const std::string &session, const std::string &error, const double timeStamp)
+{
+    result_writer::json_writer &writer = beginResult();
+    writer.StartObject();
+    writeKey(writer, ERROR_MESSAGE);
+    writer.String(error.c_str(), error.size());
+    writeKey(writer, SESSION);
+    writer.String(session.c_str(), session.size());
+    writeKey(writer, TIMESTAMP);
+    writer.Double(timeStamp);
+    writer.EndObject();
+    endResult();
+}
+
+std::string PlottingImageListener::formatResult(const std::vector <face_record> &faces) const
+{
+    rapidjson::StringBuffer &buffer = formatBuffer();
+    result_writer::json_writer writer(buffer);
+    writer.StartObject();
+    writeResult(writer, faces);
+    writer.EndObject();
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+std::string PlottingImageListener::formatError(const std::string &error)
+{
+    rapidjson::StringBuffer &buffer = formatBuffer();
+    result_writer::json_writer writer(buffer);
+    writer.StartObject();
+    writeKey(writer, ERROR_MESSAGE);
+    writer.String(error.c_str(), error.size());
+    writer.EndObject();
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+void PlottingImageListener::setClassifiers(const classifier_set &classifiers)
+{
+    mClassifiers = classifiers;
+}
+
+void PlottingImageListener::streamTo(std::ostream &file, std::size_t flushEvery)
+{
+    mWriter.reset(new result_writer(file, flushEvery));
 }
 
 void PlottingImageListener::outputToFile(std::ostream &file)
 {
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    document.Accept(writer);
+    if (mWriter)
+    {
+        mWriter->flush();
+        return;
+    }
 
-    file << buffer.GetString() << std::endl;
+    if (!mResults.IsComplete()) mResults.EndArray();
+    file << mResultBuffer.GetString() << std::endl;
 }
 
+#ifdef EMOTIONS_WITH_AFFDEX
 std::vector <cv::Point2f> PlottingImageListener::CalculateBoundingBox(VecFeaturePoint points)
 {
 
@@ -225,3 +388,4 @@ void PlottingImageListener::draw(const std::map <FaceId, Face> faces, Frame imag
     viz.showImage();
     std::lock_guard <std::mutex> lg(mMutex);
 }
+#endif
@@ -14,18 +14,30 @@
 #include <boost/filesystem.hpp>
 #include <boost/timer/timer.hpp>
 
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
-#include <rapidjson/document.h>
 
+#ifdef EMOTIONS_WITH_AFFDEX
 #include "Visualizer.h"
 #include "ImageListener.h"
+#endif
+
+#include "../classifiers.hpp"
+#include "../face_record.hpp"
+#include "../result_writer.hpp"
 
-class PlottingImageListener : public affdex::ImageListener
+/**
+ * Without the SDK, the listener only writes the results.
+ */
+class PlottingImageListener
+#ifdef EMOTIONS_WITH_AFFDEX
+        : public affdex::ImageListener
+#endif
 {
 private:
     std::mutex mMutex;
-    std::deque <std::pair<affdex::Frame, std::map < affdex::FaceId, affdex::Face>> >
-    mDataArray;
 
     double mCaptureLastTS;
     double mCaptureFPS;
@@ -35,40 +47,108 @@ private:
     const int spacing = 20;
     const float font_size = 0.5f;
     const int font = cv::FONT_HERSHEY_COMPLEX_SMALL;
+#ifdef EMOTIONS_WITH_AFFDEX
     Visualizer viz;
+#endif
+
+    /**
+     * The results are written straight to the output (or, if they are not
+     * streamed, to an array kept until outputToFile()), without building
+     * any intermediate document.
+     */
+    rapidjson::StringBuffer mResultBuffer;
+    result_writer::json_writer mResults;
+    std::unique_ptr <result_writer> mWriter;
+    classifier_set mClassifiers;
+
+    result_writer::json_writer &beginResult();
 
-    rapidjson::Document document;
+    void endResult();
+
+    void writeFace(result_writer::json_writer &writer, const face_record &f) const;
+
+    void writeResult(result_writer::json_writer &writer, const std::vector <face_record> &faces) const;
 
 public:
 
+    /**
+     * The results are handed to the listener through addResult(): as a
+     * detector listener, it only keeps the frame rates.
+     */
     PlottingImageListener();
 
+#ifdef EMOTIONS_WITH_AFFDEX
     cv::Point2f minPoint(affdex::VecFeaturePoint points);
 
     cv::Point2f maxPoint(affdex::VecFeaturePoint points);
+#endif
 
     double getProcessingFrameRate();
 
     double getCaptureFrameRate();
 
-    int getDataSize();
-
-    std::pair <affdex::Frame, std::map<affdex::FaceId, affdex::Face>> getData();
-
+#ifdef EMOTIONS_WITH_AFFDEX
     void onImageResults(std::map <affdex::FaceId, affdex::Face> faces, affdex::Frame image) override;
 
     void onImageCapture(affdex::Frame image) override;
-
-    static rapidjson::Value printFeatures(rapidjson::Document &document, float *features,
-                                          const std::vector <std::string> &viz);
-
-    void addResult(const std::map <affdex::FaceId, affdex::Face> &faces, const double timeStamp);
+#endif
+
+    void addResult(const std::vector <face_record> &faces);
+
+    /**
+     * Add the result of a frame of a session, that also contains the session
+     * and the timestamp of the frame.
+     */
+    void addResult(const std::string &session, const std::vector <face_record> &faces,
+                   const double timeStamp);
+
+    /**
+     * Add, in place of the result of an image that could not be analyzed, an
+     * object telling why (e.g. `{"error": "..."}`).
+     */
+    void addError(const std::string &error);
+
+    /**
+     * Add the error of a frame of a session, that also contains the session
+     * and the timestamp of the frame.
+     */
+    void addError(const std::string &session, const std::string &error, const double timeStamp);
+
+    /**
+     * Format a single result as a JSON object, without adding it to the
+     * results. It can be called from several threads at the same time, as
+     * long as the classifiers are not changed.
+     */
+    std::string formatResult(const std::vector <face_record> &faces) const;
+
+    /**
+     * Format, in place of a single result, an object telling why an image
+     * could not be analyzed (e.g. `{"error": "..."}`), without adding it to
+     * the results. It can be called from several threads at the same time.
+     */
+    static std::string formatError(const std::string &error);
+
+    /**
+     * Write every following result to a stream (one per line) as soon as
+     * addResult() has it, instead of collecting them for outputToFile().
+     * The stream is flushed every `flushEvery` results (0 to flush it only
+     * when the buffer is full, and by outputToFile()).
+     */
+    void streamTo(std::ostream &file, std::size_t flushEvery = 1);
+
+    /**
+     * Write, in the following results, only the sections of the given
+     * classifiers. All of them are written by default.
+     */
+    void setClassifiers(const classifier_set &classifiers);
 
     void outputToFile(std::ostream &file);
 
+#ifdef EMOTIONS_WITH_AFFDEX
     std::vector <cv::Point2f> CalculateBoundingBox(affdex::VecFeaturePoint points);
 
     void draw(const std::map <affdex::FaceId, affdex::Face> faces, affdex::Frame image);
+#endif
 
 };
 
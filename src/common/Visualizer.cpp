@@ -2,6 +2,7 @@
 #include <boost/format.hpp>
 #include "affdex_small_logo.h"
 #include <algorithm>
+#include <iterator>
 
 Visualizer::Visualizer():
         GREEN_COLOR_CLASSIFIERS({
@@ -14,28 +15,13 @@ Visualizer::Visualizer():
     logo_resized = false;
     logo = cv::imdecode(cv::InputArray(small_logo), CV_LOAD_IMAGE_UNCHANGED);
 
-    EXPRESSIONS = {
-            "smile", "innerBrowRaise", "browRaise", "browFurrow", "noseWrinkle",
-            "upperLipRaise", "lipCornerDepressor", "chinRaise", "lipPucker", "lipPress",
-            "lipSuck", "mouthOpen", "smirk", "eyeClosure", "attention", "eyeWiden", "cheekRaise",
-            "lidTighten", "dimpler", "lipStretch", "jawDrop"
-    };
-
-    EMOTIONS = {
-            "joy", "fear", "disgust", "sadness", "anger",
-            "surprise", "contempt", "valence", "engagement"
-    };
+    EXPRESSIONS.assign(std::begin(face_record::EXPRESSION_NAMES), std::end(face_record::EXPRESSION_NAMES));
 
-    HEAD_ANGLES = { "pitch", "yaw", "roll" };
+    EMOTIONS.assign(std::begin(face_record::EMOTION_NAMES), std::end(face_record::EMOTION_NAMES));
 
+    HEAD_ANGLES.assign(std::begin(face_record::HEAD_ANGLE_NAMES), std::end(face_record::HEAD_ANGLE_NAMES));
 
-    EMOJIS = std::vector<std::string> {
-            "relaxed", "smiley", "laughing",
-            "kissing", "disappointed",
-            "rage", "smirk", "wink",
-            "stuckOutTongueWinkingEye", "stuckOutTongue",
-            "flushed", "scream"
-    };
+    EMOJIS.assign(std::begin(face_record::EMOJI_NAMES), std::end(face_record::EMOJI_NAMES));
 
     GENDER_MAP = std::map<affdex::Gender, std::string> {
             { affdex::Gender::Male, "male" },
@@ -7,6 +7,8 @@
 #include <Face.h>
 #include <set>
 
+#include "../face_record.hpp"
+
 /** @brief Plot the face metrics using opencv highgui
  */
 class Visualizer
@@ -26,21 +26,21 @@
 
 #include "data_uri.hpp"
 
+#include <cstring>
+
 const std::string PROTOCOL = "data:", BASE64 = ";base64,";
 
 bool data_uri::is_data_uri(const std::string &s)
 {
-    return s.find(PROTOCOL) == 0 && s.find(BASE64) != std::string::npos;
+    return data_uri_view::is_data_uri(s.data(), s.size());
 }
 
 data_uri::data_uri(const std::string &s)
 {
-    if (!data_uri::is_data_uri(s)) throw data_uri::string_not_uri();
-
-    std::size_t base64_position = s.find(BASE64);
+    data_uri_view view(s);
 
-    m_type = s.substr(PROTOCOL.size(), base64_position - PROTOCOL.size());
-    m_data = s.substr(PROTOCOL.size() + m_type.size() + BASE64.size());
+    m_type.assign(view.get_type(), view.get_type_size());
+    m_data.assign(view.get_data(), view.get_data_size());
 }
 
 std::string data_uri::get_type() const
@@ -62,3 +62,68 @@ const char *data_uri::string_not_uri::what() const noexcept
 {
     return "The given string isn't a Data URI";
 }
+
+bool data_uri_view::parse(const char *s, std::size_t len)
+{
+    // The header ends at the first comma and must look like
+    // `data:<mediatype>;base64`.
+    const std::size_t marker_size = BASE64.size() - 1;
+    if (len < PROTOCOL.size() || std::memcmp(s, PROTOCOL.data(), PROTOCOL.size()) != 0) return false;
+
+    const char *end = s + len;
+    const char *type = s + PROTOCOL.size();
+    const char *comma = static_cast<const char *>(std::memchr(type, ',', end - type));
+    if (comma == nullptr || static_cast<std::size_t>(comma - type) < marker_size ||
+        std::memcmp(comma - marker_size, BASE64.data(), marker_size) != 0)
+    {
+        return false;
+    }
+
+    m_type = type;
+    m_type_size = comma - marker_size - type;
+    m_data = comma + 1;
+    m_data_size = end - m_data;
+    return true;
+}
+
+bool data_uri_view::is_data_uri(const char *s, std::size_t len)
+{
+    data_uri_view view;
+    return view.parse(s, len);
+}
+
+data_uri_view::data_uri_view()
+        : m_type(nullptr), m_type_size(0), m_data(nullptr), m_data_size(0)
+{
+}
+
+data_uri_view::data_uri_view(const char *s, std::size_t len)
+        : data_uri_view()
+{
+    if (!parse(s, len)) throw data_uri::string_not_uri();
+}
+
+data_uri_view::data_uri_view(const std::string &s)
+        : data_uri_view(s.data(), s.size())
+{
+}
+
+const char *data_uri_view::get_type() const
+{
+    return m_type;
+}
+
+std::size_t data_uri_view::get_type_size() const
+{
+    return m_type_size;
+}
+
+const char *data_uri_view::get_data() const
+{
+    return m_data;
+}
+
+std::size_t data_uri_view::get_data_size() const
+{
+    return m_data_size;
+}
@@ -29,6 +29,7 @@
 #ifndef EMOTIONS_DATA_URI_HPP
 #define EMOTIONS_DATA_URI_HPP
 
+#include <cstddef>
 #include <string>
 
 /**
@@ -99,9 +100,101 @@ public:
      */
     class string_not_uri : public std::exception
     {
+    public:
         const char *what() const noexcept override;
     };
 };
 
 
+/**
+ * \brief A non-owning view of a data URI.
+ *
+ * This class parses a data URI stored in a buffer owned by the caller, in a
+ * single pass and without copying it: the media type and the data are exposed
+ * as pointer and length pairs over that buffer, that must outlive the view.
+ */
+class data_uri_view
+{
+private:
+    const char *m_type;
+    std::size_t m_type_size;
+    const char *m_data;
+    std::size_t m_data_size;
+
+    /**
+     * \brief Create an empty view.
+     */
+    data_uri_view();
+
+    /**
+     * \brief Parse a buffer.
+     *
+     * \return True if the buffer is a data URI (and the view is set), false otherwise.
+     */
+    bool parse(const char *s, std::size_t len);
+
+public:
+    /**
+     * \brief Check if a buffer is a data URI.
+     *
+     * The function checks if a buffer is in the format `data:<mediatype>;base64,<data>`.
+     *
+     * \param s The buffer to be checked.
+     * \param len The length of the buffer `s`.
+     * \return True if `s` is a data URI, false otherwise.
+     */
+    static bool is_data_uri(const char *s, std::size_t len);
+
+    /**
+     * \brief The class constructor.
+     *
+     * This constructor creates a view of the data URI stored in a buffer.
+     *
+     * \param s The buffer containing the data URI.
+     * \param len The length of the buffer `s`.
+     *
+     * \throws data_uri::string_not_uri if `s` is not a valid data URI.
+     */
+    data_uri_view(const char *s, std::size_t len);
+
+    /**
+     * \brief The class constructor.
+     *
+     * This constructor creates a view of the data URI stored in a string.
+     *
+     * \param s The string representing the data uri.
+     *
+     * \throws data_uri::string_not_uri if `s` is not a valid data URI.
+     */
+    explicit data_uri_view(const std::string &s);
+
+    /**
+     * \brief Get the media type.
+     *
+     * @return A pointer to the media type (`<mediatype>` in `data:<mediatype>;base64,<data>`).
+     */
+    const char *get_type() const;
+
+    /**
+     * \brief Get the length of the media type.
+     *
+     * @return The length of the buffer returned by get_type().
+     */
+    std::size_t get_type_size() const;
+
+    /**
+     * \brief Get the data.
+     *
+     * \return A pointer to the data (`<data>` in `data:<mediatype>;base64,<data>`).
+     */
+    const char *get_data() const;
+
+    /**
+     * \brief Get the length of the data.
+     *
+     * @return The length of the buffer returned by get_data().
+     */
+    std::size_t get_data_size() const;
+};
+
 #endif //EMOTIONS_DATA_URI_HPP
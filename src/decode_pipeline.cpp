@@ -0,0 +1,162 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file decode_pipeline.cpp
+ * \brief Implementation of decode_pipeline.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "decode_pipeline.hpp"
+
+#include <algorithm>
+#include <exception>
+
+decode_pipeline::decode_pipeline(image_source &source, const decode_limits &limits, frame_pool &pool,
+                                 std::size_t threads, std::size_t depth)
+        : m_source(source), m_limits(limits), m_pool(pool), m_depth(std::max<std::size_t>(depth, 1)),
+          m_next_read(0), m_next_out(0), m_exhausted(false), m_stopping(false)
+{
+    for (std::size_t i = 0; i < threads; i++)
+    {
+        m_workers.emplace_back([this]()
+                               {
+                                   raw_image raw;
+                                   std::vector<unsigned char> buffer;
+                                   while (produce(raw, buffer, true));
+                               });
+    }
+}
+
+decode_pipeline::~decode_pipeline()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_space.notify_all();
+    for (auto &worker : m_workers) worker.join();
+}
+
+bool decode_pipeline::produce(raw_image &raw, std::vector<unsigned char> &buffer, bool wait)
+{
+    // Holding the source lock, images are read (and numbered) in order.
+    std::unique_lock<std::mutex> source_lock(m_source_mutex);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (wait)
+        {
+            m_space.wait(lock, [this]()
+            {
+                return m_stopping || m_exhausted || m_next_read < m_next_out + m_depth;
+            });
+        }
+        if (m_stopping || m_exhausted) return false;
+    }
+
+    decoded_image image;
+    bool read;
+    try
+    {
+        read = m_source.read(raw);
+    }
+    catch (std::exception &e)
+    {
+        // Whatever went wrong (e.g. an unreadable stream), only this image is skipped.
+        read = true;
+        image.error = e.what();
+    }
+
+    std::size_t index;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!read)
+        {
+            m_exhausted = true;
+            m_ready.notify_all();
+            m_space.notify_all();
+            return false;
+        }
+        index = m_next_read++;
+    }
+    source_lock.unlock();
+    image.index = index;
+
+    if (image.error.empty())
+    {
+        try
+        {
+            // Whatever went wrong (e.g. an invalid data URI or an unreadable file), only this image is skipped.
+            raw.decode(buffer);
+            image.pixels = decode_image(buffer, m_limits, m_pool);
+            if (image.pixels.empty())
+            {
+                image.error = "Unable to decode an image";
+            }
+            else
+            {
+                const image_frame::color_format format = frame_format(image.pixels, m_pool);
+                image.frame.reset(new image_frame(make_frame(image.pixels, format)));
+            }
+        }
+        catch (std::exception &e)
+        {
+            // The same holds for a cv::Exception from an image OpenCV refuses, or std::bad_alloc.
+            image.pixels.release();
+            image.frame.reset();
+            image.error = e.what();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done.emplace(index, std::move(image));
+    }
+    m_ready.notify_all();
+    return true;
+}
+
+bool decode_pipeline::next(decoded_image &image)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_workers.empty())
+    {
+        lock.unlock();
+        raw_image raw;
+        std::vector<unsigned char> buffer;
+        produce(raw, buffer, false);
+        lock.lock();
+    }
+
+    m_ready.wait(lock, [this]()
+    {
+        return m_done.count(m_next_out) > 0 || (m_exhausted && m_next_out == m_next_read);
+    });
+
+    auto it = m_done.find(m_next_out);
+    if (it == m_done.end()) return false;
+
+    image = std::move(it->second);
+    m_done.erase(it);
+    m_next_out++;
+    lock.unlock();
+    m_space.notify_all();
+    return true;
+}
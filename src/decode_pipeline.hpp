@@ -0,0 +1,131 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file decode_pipeline.hpp
+ * \brief An header to decode the images ahead of the detector.
+ *
+ * This header contains the pipeline stage decoding, on a pool of threads, the images the detector will need next.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_DECODE_PIPELINE_HPP
+#define EMOTIONS_DECODE_PIPELINE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include "frame_pool.hpp"
+#include "image_decoder.hpp"
+#include "image_source.hpp"
+
+/**
+ * \brief An image ready to be analyzed.
+ */
+struct decoded_image
+{
+    cv::Mat pixels; ///< The pixels of the image, empty if the image could not be decoded.
+    std::unique_ptr<image_frame> frame; ///< The frame wrapping `pixels`, null if the image could not be decoded.
+    std::string error; ///< Why the image could not be decoded.
+    std::size_t index; ///< The position of the image in the source.
+};
+
+/**
+ * \brief A pipeline stage decoding the images ahead of the detector.
+ *
+ * This class reads the images from a source and decodes them (base64, `cv::imdecode`, downscaling and color format)
+ * on a pool of threads, staying up to a fixed number of images ahead of the consumer. The consumer gets the images in
+ * the order of the source, already wrapped in an image_frame.
+ *
+ * Several consumers can share the pipeline: each image is handed to only one of them.
+ */
+class decode_pipeline
+{
+private:
+    image_source &m_source;
+    const decode_limits m_limits;
+    frame_pool &m_pool;
+    const std::size_t m_depth;
+
+    std::mutex m_source_mutex;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::condition_variable m_space;
+    std::map<std::size_t, decoded_image> m_done;
+    std::size_t m_next_read;
+    std::size_t m_next_out;
+    bool m_exhausted;
+    bool m_stopping;
+    std::vector<std::thread> m_workers;
+
+    /**
+     * \brief Read and decode the next image of the source.
+     *
+     * Only reading the image holds the source: its payload is decoded while other threads read the following ones.
+     *
+     * \param raw A variable for the image read from the source.
+     * \param buffer A buffer for the bytes of the image.
+     * \param wait Whether to wait for room in the queue.
+     * \return False if nothing has been (or will ever be) decoded, true otherwise.
+     */
+    bool produce(raw_image &raw, std::vector<unsigned char> &buffer, bool wait);
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * This constructor starts the decoding threads.
+     *
+     * \param source The source of the images.
+     * \param limits The limits on the size of the decoded images.
+     * \param pool The pool of the buffers to be reused.
+     * \param threads The number of decoding threads. If 0, the images are decoded by next(), one per call.
+     * \param depth The maximum number of images decoded ahead of the consumer.
+     */
+    decode_pipeline(image_source &source, const decode_limits &limits, frame_pool &pool, std::size_t threads,
+                    std::size_t depth);
+
+    /**
+     * \brief The class destructor.
+     *
+     * This destructor stops and joins the decoding threads.
+     */
+    ~decode_pipeline();
+
+    /**
+     * \brief Get the next image.
+     *
+     * This function waits until the next image (in the order of the source) is decoded.
+     *
+     * \param image A variable that will contain the image.
+     * \return True if an image has been returned, false if the source is exhausted.
+     */
+    bool next(decoded_image &image);
+};
+
+#endif //EMOTIONS_DECODE_PIPELINE_HPP
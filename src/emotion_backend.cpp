@@ -0,0 +1,47 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file emotion_backend.cpp
+ * \brief Implementation of emotion_backend.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "emotion_backend.hpp"
+
+const char *emotion_backend::timed_out::what() const noexcept
+{
+    return "The analysis of the image timed out";
+}
+
+analysis emotion_backend::analyze(const image_frame &frame, std::chrono::milliseconds timeout)
+{
+    const std::chrono::steady_clock::time_point deadline = timeout.count() > 0
+                                                           ? std::chrono::steady_clock::now() + timeout
+                                                           : std::chrono::steady_clock::time_point::max();
+    std::future<analysis> result = submit(frame, deadline);
+    if (timeout.count() > 0 && result.wait_until(deadline) != std::future_status::ready)
+    {
+        recover();
+        // A backend may also give up the frame without fulfilling its future.
+        if (result.wait_for(std::chrono::milliseconds::zero()) != std::future_status::ready) throw timed_out();
+    }
+    return result.get();
+}
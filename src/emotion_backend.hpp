@@ -0,0 +1,101 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file emotion_backend.hpp
+ * \brief An header containing the interface of the emotion analysis.
+ *
+ * This header contains the interface every backend analyzing the faces in the images implements.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_EMOTION_BACKEND_HPP
+#define EMOTIONS_EMOTION_BACKEND_HPP
+
+#include <chrono>
+#include <exception>
+#include <future>
+
+#include "face_record.hpp"
+#include "image_frame.hpp"
+
+/**
+ * \brief A backend analyzing the faces in the images.
+ *
+ * Each frame submitted to a backend gets a future, ready when the results of the frame are available. A backend can
+ * be used from any thread, and analyzes the frames in the order they are submitted.
+ */
+class emotion_backend
+{
+public:
+    /**
+     * \brief An exception raised if the backend takes too long to analyze a frame.
+     */
+    class timed_out : public std::exception
+    {
+    public:
+        const char *what() const noexcept override;
+    };
+
+    virtual ~emotion_backend() = default;
+
+    /**
+     * \brief Submit a frame.
+     *
+     * This function does not wait for the frames submitted before. The frame is copied, but not its pixels: they must
+     * stay valid (and unchanged) as long as the backend may use them, which, if the frame is given up, may be after
+     * its future is ready. Frames created by make_frame() keep their pixels allocated.
+     *
+     * \param frame The frame to be analyzed.
+     * \param deadline The time the frame can be given up at (see recover()).
+     * \return The future results of the analysis. If the backend fails, the future holds the exception.
+     */
+    virtual std::future<analysis> submit(const image_frame &frame,
+                                         std::chrono::steady_clock::time_point deadline) = 0;
+
+    /**
+     * \brief Give up the frames past their deadline.
+     *
+     * The futures of the frames past their deadline, whose results are not available yet, get a timed_out exception,
+     * and the backend gets ready to analyze the next frames.
+     */
+    virtual void recover() = 0;
+
+    /**
+     * \brief Forget the faces tracked in the previous frames.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * \brief Analyze a frame within a deadline.
+     *
+     * This function submits a frame and waits for its results. If they are not available in time, the backend is
+     * recovered (see recover()). The time taken by the backend to accept the frame counts towards the timeout.
+     *
+     * \param frame The frame to be analyzed.
+     * \param timeout The maximum time to wait for the results, or 0 to wait as long as needed.
+     * \return The results of the analysis.
+     *
+     * \throws timed_out if the results are not available in time.
+     */
+    analysis analyze(const image_frame &frame, std::chrono::milliseconds timeout);
+};
+
+#endif //EMOTIONS_EMOTION_BACKEND_HPP
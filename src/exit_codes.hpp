@@ -39,7 +39,9 @@ enum class exit_codes : int
     OK = 0, ///< The tool exited with no error completing its tasks.
     HALT = 1, ///< The tool exited with no error, but without completing its tasks.
     ARGUMENT_ERROR = 2, ///< The tool exited due to errors in the given arguments.
-    UNKNOWN_ARGUMENT_ERROR = 3 ///< The tool exited due to unknown errors while parsing the arguments.
+    UNKNOWN_ARGUMENT_ERROR = 3, ///< The tool exited due to unknown errors while parsing the arguments.
+    SERVER_ERROR = 4, ///< The tool exited since it could not listen on the given socket.
+    SHARD_ERROR = 5 ///< The tool exited since (at least) a shard could not be analyzed.
 };
 
 #endif //EMOTIONS_EXIT_CODES_HPP
@@ -0,0 +1,135 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file face_record.cpp
+ * \brief Implementation of face_record.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "face_record.hpp"
+
+#include <algorithm>
+
+const std::size_t face_record::EMOTIONS;
+const std::size_t face_record::EXPRESSIONS;
+const std::size_t face_record::EMOJIS;
+const std::size_t face_record::HEAD_ANGLES;
+constexpr const char *face_record::EMOTION_NAMES[];
+constexpr const char *face_record::EXPRESSION_NAMES[];
+constexpr const char *face_record::EMOJI_NAMES[];
+constexpr const char *face_record::HEAD_ANGLE_NAMES[];
+constexpr const char *face_record::AGE_NAMES[];
+constexpr const char *face_record::ETHNICITY_NAMES[];
+constexpr const char *face_record::GENDER_NAMES[];
+
+#ifdef EMOTIONS_WITH_AFFDEX
+namespace
+{
+    /**
+     * \brief The values of the SDK, in the same order as the ones of the records.
+     */
+    const affdex::Emoji AFFDEX_EMOJIS[] = {
+            affdex::Emoji::Relaxed, affdex::Emoji::Smiley, affdex::Emoji::Laughing, affdex::Emoji::Kissing,
+            affdex::Emoji::Disappointed, affdex::Emoji::Rage, affdex::Emoji::Smirk, affdex::Emoji::Wink,
+            affdex::Emoji::StuckOutTongueWinkingEye, affdex::Emoji::StuckOutTongue, affdex::Emoji::Flushed,
+            affdex::Emoji::Scream, affdex::Emoji::Unknown
+    };
+    const affdex::Age AFFDEX_AGES[] = {
+            affdex::Age::AGE_UNKNOWN, affdex::Age::AGE_UNDER_18, affdex::Age::AGE_18_24, affdex::Age::AGE_25_34,
+            affdex::Age::AGE_35_44, affdex::Age::AGE_45_54, affdex::Age::AGE_55_64, affdex::Age::AGE_65_PLUS
+    };
+    const affdex::Ethnicity AFFDEX_ETHNICITIES[] = {
+            affdex::Ethnicity::UNKNOWN, affdex::Ethnicity::CAUCASIAN, affdex::Ethnicity::BLACK_AFRICAN,
+            affdex::Ethnicity::SOUTH_ASIAN, affdex::Ethnicity::EAST_ASIAN, affdex::Ethnicity::HISPANIC
+    };
+    const affdex::Gender AFFDEX_GENDERS[] = {affdex::Gender::Unknown, affdex::Gender::Male, affdex::Gender::Female};
+
+    /**
+     * \brief Convert a value of the SDK, through its position in a table.
+     *
+     * \return The converted value, or `unknown` if the table does not list it.
+     */
+    template<typename R, typename A, std::size_t N>
+    R convert(const A (&values)[N], A value, R unknown)
+    {
+        const A *found = std::find(values, values + N, value);
+        return found != values + N ? static_cast<R>(found - values) : unknown;
+    }
+}
+
+const std::string &face_record::emoji_name(emoji_type emoji)
+{
+    // The names are converted only once.
+    static const std::vector<std::string> names = []
+    {
+        std::vector<std::string> all;
+        for (affdex::Emoji e : AFFDEX_EMOJIS) all.push_back(affdex::EmojiToString(e));
+        return all;
+    }();
+    return names[static_cast<std::size_t>(emoji)];
+}
+
+face_record face_record::from(const affdex::Face &face)
+{
+    const affdex::Emotions &e = face.emotions;
+    const affdex::Expressions &x = face.expressions;
+    const affdex::Emojis &j = face.emojis;
+    const affdex::Orientation &o = face.measurements.orientation;
+
+    face_record record;
+    record.id = face.id;
+    record.emotions = {{e.joy, e.fear, e.disgust, e.sadness, e.anger, e.surprise, e.contempt, e.valence,
+                        e.engagement}};
+    record.expressions = {{x.smile, x.innerBrowRaise, x.browRaise, x.browFurrow, x.noseWrinkle, x.upperLipRaise,
+                           x.lipCornerDepressor, x.chinRaise, x.lipPucker, x.lipPress, x.lipSuck, x.mouthOpen,
+                           x.smirk, x.eyeClosure, x.attention, x.eyeWiden, x.cheekRaise, x.lidTighten, x.dimpler,
+                           x.lipStretch, x.jawDrop}};
+    record.emojis = {{j.relaxed, j.smiley, j.laughing, j.kissing, j.disappointed, j.rage, j.smirk, j.wink,
+                      j.stuckOutTongueWinkingEye, j.stuckOutTongue, j.flushed, j.scream}};
+    record.orientation = {{o.pitch, o.yaw, o.roll}};
+    record.interocular_distance = face.measurements.interocularDistance;
+    record.dominant_emoji = convert(AFFDEX_EMOJIS, j.dominantEmoji, emoji_type::unknown);
+    record.glasses = face.appearance.glasses == affdex::Glasses::Yes;
+    record.age = convert(AFFDEX_AGES, face.appearance.age, age_type::unknown);
+    record.ethnicity = convert(AFFDEX_ETHNICITIES, face.appearance.ethnicity, ethnicity_type::unknown);
+    record.gender = convert(AFFDEX_GENDERS, face.appearance.gender, gender_type::unknown);
+    return record;
+}
+
+std::vector<face_record> to_records(const std::map<affdex::FaceId, affdex::Face> &faces)
+{
+    std::vector<face_record> records;
+    records.reserve(faces.size());
+    for (const auto &face : faces) records.push_back(face_record::from(face.second));
+    return records;
+}
+#else
+const std::string &face_record::emoji_name(emoji_type emoji)
+{
+    static const std::vector<std::string> names = []
+    {
+        std::vector<std::string> all(EMOJI_NAMES, EMOJI_NAMES + EMOJIS);
+        all.push_back("unknown");
+        return all;
+    }();
+    return names[static_cast<std::size_t>(emoji)];
+}
+#endif
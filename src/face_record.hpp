@@ -0,0 +1,171 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file face_record.hpp
+ * \brief An header containing the compact results of the analysis.
+ *
+ * This header contains the flat records the faces found by the detector are converted to, as soon as they are
+ * reported.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_FACE_RECORD_HPP
+#define EMOTIONS_FACE_RECORD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef EMOTIONS_WITH_AFFDEX
+#include <Face.h>
+#endif
+
+/**
+ * \brief The results of the analysis of a face.
+ *
+ * This structure has a fixed layout, holding only the values written in the results: unlike `affdex::Face`, it has
+ * no feature points nor any other allocated member, and it does not depend on the SDK. The values of each group are
+ * in the same order as their names.
+ */
+struct face_record
+{
+    static const std::size_t EMOTIONS = 9; ///< The number of emotions.
+    static const std::size_t EXPRESSIONS = 21; ///< The number of expressions.
+    static const std::size_t EMOJIS = 12; ///< The number of emojis.
+    static const std::size_t HEAD_ANGLES = 3; ///< The number of head angles.
+
+    /**
+     * \brief The names of the values of each group, as written in the results.
+     */
+    static constexpr const char *EMOTION_NAMES[EMOTIONS] = {
+            "joy", "fear", "disgust", "sadness", "anger",
+            "surprise", "contempt", "valence", "engagement"
+    };
+    static constexpr const char *EXPRESSION_NAMES[EXPRESSIONS] = {
+            "smile", "innerBrowRaise", "browRaise", "browFurrow", "noseWrinkle",
+            "upperLipRaise", "lipCornerDepressor", "chinRaise", "lipPucker", "lipPress",
+            "lipSuck", "mouthOpen", "smirk", "eyeClosure", "attention", "eyeWiden", "cheekRaise",
+            "lidTighten", "dimpler", "lipStretch", "jawDrop"
+    };
+    static constexpr const char *EMOJI_NAMES[EMOJIS] = {
+            "relaxed", "smiley", "laughing",
+            "kissing", "disappointed",
+            "rage", "smirk", "wink",
+            "stuckOutTongueWinkingEye", "stuckOutTongue",
+            "flushed", "scream"
+    };
+    static constexpr const char *HEAD_ANGLE_NAMES[HEAD_ANGLES] = {"pitch", "yaw", "roll"};
+
+    /**
+     * \brief The emojis, in the same order as the values of `emojis`.
+     */
+    enum class emoji_type : std::uint8_t
+    {
+        relaxed, smiley, laughing, kissing, disappointed, rage, smirk, wink, stuck_out_tongue_winking_eye,
+        stuck_out_tongue, flushed, scream, unknown
+    };
+
+    /**
+     * \brief The age ranges, in the same order as their names (AGE_NAMES).
+     */
+    enum class age_type : std::uint8_t
+    {
+        unknown, under_18, from_18_to_24, from_25_to_34, from_35_to_44, from_45_to_54, from_55_to_64, over_64
+    };
+    static constexpr const char *AGE_NAMES[] = {
+            "unknown", "under 18", "18-24", "25-34", "35-44", "45-54", "55-64", "65 plus"
+    };
+
+    /**
+     * \brief The ethnicities, in the same order as their names (ETHNICITY_NAMES).
+     */
+    enum class ethnicity_type : std::uint8_t
+    {
+        unknown, caucasian, black_african, south_asian, east_asian, hispanic
+    };
+    static constexpr const char *ETHNICITY_NAMES[] = {
+            "unknown", "caucasian", "black african", "south asian", "east asian", "hispanic"
+    };
+
+    /**
+     * \brief The genders, in the same order as their names (GENDER_NAMES).
+     */
+    enum class gender_type : std::uint8_t
+    {
+        unknown, male, female
+    };
+    static constexpr const char *GENDER_NAMES[] = {"unknown", "male", "female"};
+
+    int id; ///< The identifier of the face.
+    std::array<float, EMOTIONS> emotions; ///< The emotions.
+    std::array<float, EXPRESSIONS> expressions; ///< The expressions.
+    std::array<float, EMOJIS> emojis; ///< The emojis.
+    std::array<float, HEAD_ANGLES> orientation; ///< The orientation of the head.
+    float interocular_distance; ///< The distance between the eyes.
+    emoji_type dominant_emoji; ///< The dominant emoji.
+    bool glasses; ///< Whether the subject wears glasses.
+    age_type age; ///< The age range of the subject.
+    ethnicity_type ethnicity; ///< The ethnicity of the subject.
+    gender_type gender; ///< The gender of the subject.
+
+    /**
+     * \brief Get the name of an emoji.
+     *
+     * \param emoji The emoji.
+     * \return The name of the emoji, as the SDK spells it (or, without the SDK, as the name of its value).
+     */
+    static const std::string &emoji_name(emoji_type emoji);
+
+#ifdef EMOTIONS_WITH_AFFDEX
+    /**
+     * \brief Convert a face.
+     *
+     * Any appearance or emoji the results cannot name is converted to the unknown one.
+     *
+     * \param face The face reported by the detector.
+     * \return The record of the face.
+     */
+    static face_record from(const affdex::Face &face);
+#endif
+};
+
+#ifdef EMOTIONS_WITH_AFFDEX
+/**
+ * \brief Convert the faces reported by the detector.
+ *
+ * \param faces The faces, by identifier.
+ * \return The records of the faces, sorted by identifier.
+ */
+std::vector<face_record> to_records(const std::map<affdex::FaceId, affdex::Face> &faces);
+#endif
+
+/**
+ * \brief The results of the analysis of an image.
+ */
+struct analysis
+{
+    std::vector<face_record> faces; ///< The faces found in the image, sorted by identifier.
+};
+
+#endif //EMOTIONS_FACE_RECORD_HPP
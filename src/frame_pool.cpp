@@ -0,0 +1,57 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file frame_pool.cpp
+ * \brief Implementation of frame_pool.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "frame_pool.hpp"
+
+frame_pool::frame_pool(std::size_t capacity)
+        : m_capacity(capacity)
+{
+}
+
+cv::Mat frame_pool::acquire(int width, int height, int type)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it)
+    {
+        if (it->cols == width && it->rows == height && it->type() == type)
+        {
+            cv::Mat buffer = *it;
+            m_buffers.erase(it);
+            return buffer;
+        }
+    }
+    return cv::Mat();
+}
+
+void frame_pool::release(cv::Mat buffer)
+{
+    if (buffer.empty() || m_capacity == 0) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_buffers.size() == m_capacity) m_buffers.pop_back();
+    m_buffers.push_front(buffer);
+}
@@ -0,0 +1,80 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file frame_pool.hpp
+ * \brief An header to reuse the buffers of the decoded images.
+ *
+ * This header contains the pool recycling the pixel buffers handed to the detector.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_FRAME_POOL_HPP
+#define EMOTIONS_FRAME_POOL_HPP
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+
+#include <opencv2/core/core.hpp>
+
+/**
+ * \brief A pool of frame buffers.
+ *
+ * This class keeps the buffers of the images already analyzed, keyed by their width, height and type, so that the
+ * following images of the same size are decoded into them instead of into freshly allocated memory. At most a fixed
+ * number of buffers is kept: the least recently released ones are freed first. The pool is thread-safe.
+ */
+class frame_pool
+{
+private:
+    std::mutex m_mutex;
+    std::list<cv::Mat> m_buffers;
+    std::size_t m_capacity;
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param capacity The maximum number of buffers kept by the pool.
+     */
+    explicit frame_pool(std::size_t capacity = 4);
+
+    /**
+     * \brief Take a buffer from the pool.
+     *
+     * \param width The width of the buffer.
+     * \param height The height of the buffer.
+     * \param type The type of the buffer (e.g. `CV_8UC3`).
+     * \return A buffer with the given size and type, or an empty matrix if the pool has none.
+     */
+    cv::Mat acquire(int width, int height, int type);
+
+    /**
+     * \brief Give a buffer back to the pool.
+     *
+     * The buffer must not be used anymore by the caller.
+     *
+     * \param buffer The buffer.
+     */
+    void release(cv::Mat buffer);
+};
+
+#endif //EMOTIONS_FRAME_POOL_HPP
@@ -0,0 +1,221 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file image_decoder.cpp
+ * \brief Implementation of image_decoder.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "image_decoder.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+namespace
+{
+    /**
+     * \brief Compute the size of an image fitting the limits.
+     *
+     * \return The largest size, with the aspect ratio of the image, that fits the limits.
+     */
+    cv::Size fit_size(int width, int height, const decode_limits &limits)
+    {
+        double scale = 1;
+        if (limits.max_pixels > 0 && static_cast<double>(width) * height > limits.max_pixels)
+        {
+            scale = std::sqrt(limits.max_pixels / (static_cast<double>(width) * height));
+        }
+        if (limits.max_dimension > 0 && std::max(width, height) > limits.max_dimension)
+        {
+            scale = std::min(scale, static_cast<double>(limits.max_dimension) / std::max(width, height));
+        }
+
+        return cv::Size(std::max(1, static_cast<int>(width * scale)), std::max(1, static_cast<int>(height * scale)));
+    }
+
+    /**
+     * \brief Read a big-endian 16-bit integer.
+     */
+    int read_u16(const unsigned char *p)
+    {
+        return (p[0] << 8) | p[1];
+    }
+
+    /**
+     * \brief Read a big-endian 32-bit integer.
+     */
+    std::uint32_t read_u32(const unsigned char *p)
+    {
+        return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16) |
+               (static_cast<std::uint32_t>(p[2]) << 8) | p[3];
+    }
+}
+
+bool probe_image(const std::vector<unsigned char> &image, image_info &info)
+{
+    static const unsigned char PNG_SIGNATURE[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+
+    if (image.size() >= 26 && std::equal(PNG_SIGNATURE, PNG_SIGNATURE + 8, image.begin()))
+    {
+        // The IHDR chunk always comes first. The sizes are at most 2^31 - 1, but any header can claim more.
+        const std::uint32_t width = read_u32(&image[16]);
+        const std::uint32_t height = read_u32(&image[20]);
+        if (width > INT_MAX || height > INT_MAX) return false;
+        info.width = static_cast<int>(width);
+        info.height = static_cast<int>(height);
+
+        const int depth = image[24] == 16 ? CV_16U : CV_8U;
+        const int color_type = image[25];
+        const int channels = color_type == 0 ? 1 : (color_type & 4) ? 4 : 3;
+        info.type = CV_MAKETYPE(depth, channels);
+        info.jpeg = false;
+        return info.width > 0 && info.height > 0;
+    }
+
+    if (image.size() < 4 || image[0] != 0xff || image[1] != 0xd8) return false;
+
+    // Walk the marker segments up to the start of frame.
+    std::size_t i = 2;
+    while (i + 4 <= image.size())
+    {
+        if (image[i] != 0xff) return false;
+
+        const unsigned char marker = image[i + 1];
+        if (marker == 0xff)
+        {
+            i++;
+            continue;
+        }
+
+        const std::size_t length = read_u16(&image[i + 2]);
+        const bool start_of_frame = marker >= 0xc0 && marker <= 0xcf &&
+                                    marker != 0xc4 && marker != 0xc8 && marker != 0xcc;
+        if (start_of_frame)
+        {
+            if (i + 10 > image.size()) return false;
+            info.height = read_u16(&image[i + 5]);
+            info.width = read_u16(&image[i + 7]);
+            info.type = image[i + 9] == 1 ? CV_8UC1 : CV_8UC3;
+            info.jpeg = true;
+            return info.width > 0 && info.height > 0;
+        }
+        i += 2 + length;
+    }
+    return false;
+}
+
+cv::Mat decode_image(const std::vector<unsigned char> &image, const decode_limits &limits, frame_pool &pool)
+{
+    // Unless the image is already in a layout the detector accepts (8-bit BGR
+    // or BGRA), let the decoder produce 8-bit BGR while decoding. Like
+    // IMREAD_UNCHANGED, ignore the EXIF orientation.
+    int flags = cv::IMREAD_COLOR | cv::IMREAD_IGNORE_ORIENTATION;
+
+    image_info info;
+    cv::Mat img;
+    if (probe_image(image, info))
+    {
+        int width = info.width, height = info.height, type = CV_8UC3;
+        if (info.type == CV_8UC3 || info.type == CV_8UC4)
+        {
+            flags = cv::IMREAD_UNCHANGED;
+            type = info.type;
+        }
+
+        if (info.jpeg && (limits.max_pixels > 0 || limits.max_dimension > 0))
+        {
+            const cv::Size target = fit_size(info.width, info.height, limits);
+
+            const int reduced[] = {cv::IMREAD_REDUCED_COLOR_8, cv::IMREAD_REDUCED_COLOR_4, cv::IMREAD_REDUCED_COLOR_2};
+            const int denominators[] = {8, 4, 2};
+            for (std::size_t i = 0; i < 3; i++)
+            {
+                if (info.width / denominators[i] >= target.width && info.height / denominators[i] >= target.height)
+                {
+                    flags = reduced[i] | cv::IMREAD_IGNORE_ORIENTATION;
+                    width = (info.width + denominators[i] - 1) / denominators[i];
+                    height = (info.height + denominators[i] - 1) / denominators[i];
+                    type = CV_8UC3;
+                    break;
+                }
+            }
+        }
+        img = pool.acquire(width, height, type);
+    }
+
+    // A buffer of the wrong size or type (if the guess was wrong) is simply
+    // reallocated by imdecode.
+    cv::imdecode(image, flags, &img);
+    if (img.empty()) return img;
+
+    const cv::Size target = fit_size(img.cols, img.rows, limits);
+    if (target.width < img.cols || target.height < img.rows)
+    {
+        cv::Mat resized = pool.acquire(target.width, target.height, img.type());
+        cv::resize(img, resized, target, 0, 0, cv::INTER_AREA);
+        pool.release(img);
+        return resized;
+    }
+    return img;
+}
+
+image_frame::color_format frame_format(cv::Mat &img, frame_pool &pool)
+{
+    if (img.type() == CV_8UC3) return image_frame::color_format::BGR;
+    if (img.type() == CV_8UC4) return image_frame::color_format::BGRA;
+
+    // No other choice: convert to 8-bit BGR.
+    cv::Mat source = img;
+    if (source.depth() != CV_8U)
+    {
+        const double scale = source.depth() == CV_16U ? 1.0 / 256 : source.depth() == CV_32F ? 255 : 1;
+        source.convertTo(source, CV_8U, scale);
+    }
+
+    cv::Mat converted = source;
+    if (source.channels() != 3)
+    {
+        converted = pool.acquire(img.cols, img.rows, CV_8UC3);
+        cv::cvtColor(source, converted, source.channels() == 1 ? cv::COLOR_GRAY2BGR : cv::COLOR_BGRA2BGR);
+    }
+
+    if (converted.data != img.data) pool.release(img);
+    img = converted;
+    return image_frame::color_format::BGR;
+}
+
+image_frame make_frame(const cv::Mat &img, image_frame::color_format format, float timestamp)
+{
+    image_frame frame;
+    frame.width = img.cols;
+    frame.height = img.rows;
+    frame.format = format;
+    // The deleter holds a reference to the matrix.
+    frame.pixels = std::shared_ptr<unsigned char>(img.data, [img](unsigned char *) {});
+    frame.timestamp = timestamp;
+    return frame;
+}
@@ -0,0 +1,118 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file image_decoder.hpp
+ * \brief An header to decode the images to be analyzed.
+ *
+ * This header contains the functions turning the bytes of an image file into the pixels given to the detector.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_IMAGE_DECODER_HPP
+#define EMOTIONS_IMAGE_DECODER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include "frame_pool.hpp"
+#include "image_frame.hpp"
+
+/**
+ * \brief The limits on the size of the decoded images.
+ *
+ * Images exceeding any of the limits are downscaled, keeping their aspect ratio, until they fit. A limit equal to 0
+ * is disabled.
+ */
+struct decode_limits
+{
+    std::size_t max_pixels = 0; ///< The maximum number of pixels (width times height).
+    int max_dimension = 0; ///< The maximum width and height.
+};
+
+/**
+ * \brief The properties of an image file.
+ */
+struct image_info
+{
+    int width; ///< The width of the image.
+    int height; ///< The height of the image.
+    int type; ///< The type of the matrix `cv::imdecode` returns with `cv::IMREAD_UNCHANGED` (e.g. `CV_8UC3`).
+    bool jpeg; ///< Whether the image is a JPEG image.
+};
+
+/**
+ * \brief Read the properties of an image.
+ *
+ * This function reads the properties of a JPEG or PNG image from its header, without decoding it.
+ *
+ * \param image The bytes of the image file.
+ * \param info A variable that will contain the properties of the image.
+ * \return True if `image` is a JPEG or PNG image and its properties have been found, false otherwise.
+ */
+bool probe_image(const std::vector<unsigned char> &image, image_info &info);
+
+/**
+ * \brief Decode an image.
+ *
+ * This function decodes an image, downscaling it to fit the given limits. JPEG images are decoded at a reduced scale
+ * (1/2, 1/4 or 1/8, computed in the DCT domain by the decoder) whenever that does not go below the limits; any
+ * further downscaling (and the downscaling of any other format) uses an area resize.
+ *
+ * Images are decoded once, straight into a layout the detector accepts whenever possible: 8-bit BGR and BGRA images
+ * are kept as they are, while the decoder itself expands any other image (e.g. grayscale or 16-bit) to 8-bit BGR.
+ *
+ * The pixels are written into buffers taken from `pool` whenever it has some of the right size.
+ *
+ * \param image The bytes of the image file.
+ * \param limits The limits on the size of the decoded image.
+ * \param pool The pool of the buffers to be reused.
+ * \return The decoded image, or an empty matrix if `image` cannot be decoded.
+ */
+cv::Mat decode_image(const std::vector<unsigned char> &image, const decode_limits &limits, frame_pool &pool);
+
+/**
+ * \brief Find the color format of a decoded image.
+ *
+ * This function maps the type of a decoded image to the matching color format of the detector. Only if the detector
+ * does not support the type (which decode_image() avoids whenever it can), the image is converted to 8-bit BGR.
+ *
+ * \param img The decoded image, replaced by its conversion if needed.
+ * \param pool The pool of the buffers to be reused.
+ * \return The color format of `img`.
+ */
+image_frame::color_format frame_format(cv::Mat &img, frame_pool &pool);
+
+/**
+ * \brief Wrap a decoded image in a frame.
+ *
+ * The frame shares the pixels of the image, and keeps them allocated as long as it (or any copy of it) exists, even
+ * once the image is released.
+ *
+ * \param img The decoded image.
+ * \param format The color format of `img` (see frame_format()).
+ * \param timestamp The timestamp of the frame, in seconds.
+ * \return The frame.
+ */
+image_frame make_frame(const cv::Mat &img, image_frame::color_format format, float timestamp = 0);
+
+#endif //EMOTIONS_IMAGE_DECODER_HPP
@@ -0,0 +1,69 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * \file image_frame.hpp
+ * \brief An header containing the images handed to the backends.
+ *
+ * This header contains the frame type shared by the decoder and the backends, independent of the Affdex SDK.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_IMAGE_FRAME_HPP
+#define EMOTIONS_IMAGE_FRAME_HPP
+
+#include <cstddef>
+#include <memory>
+
+/**
+ * \brief A decoded image to be analyzed.
+ *
+ * A frame shares its pixels: its copies are cheap, and keep the pixels allocated as long as any of them exists. The
+ * rows of pixels are contiguous.
+ */
+struct image_frame
+{
+    /**
+     * \brief The layout of the pixels.
+     */
+    enum class color_format
+    {
+        BGR, ///< 8-bit blue, green and red.
+        BGRA ///< 8-bit blue, green, red and alpha.
+    };
+
+    int width = 0; ///< The width of the image.
+    int height = 0; ///< The height of the image.
+    color_format format = color_format::BGR; ///< The layout of the pixels.
+    std::shared_ptr<unsigned char> pixels; ///< The pixels, row by row.
+    float timestamp = 0; ///< The timestamp of the frame, in seconds.
+
+    /**
+     * \brief Get the size of the pixels.
+     *
+     * \return The number of bytes of the pixels.
+     */
+    std::size_t size() const
+    {
+        const std::size_t channels = format == color_format::BGRA ? 4 : 3;
+        return static_cast<std::size_t>(width) * height * channels;
+    }
+};
+
+#endif //EMOTIONS_IMAGE_FRAME_HPP
@@ -0,0 +1,138 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file image_source.cpp
+ * \brief Implementation of image_source.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "image_source.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+#include <boost/filesystem.hpp>
+
+#include "data_uri.hpp"
+#include "utilities.hpp"
+
+void raw_image::decode(std::vector<unsigned char> &image) const
+{
+    if (uri)
+    {
+        decode_data_uri(data_uri_view(uri, uri_size), image);
+    }
+    else if (path == STDIN_IMAGE)
+    {
+        // The standard input could be given more than once.
+        static std::mutex stdin_mutex;
+        std::lock_guard<std::mutex> lock(stdin_mutex);
+        read_image(std::cin, image);
+    }
+    else
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        image.reserve(boost::filesystem::file_size(path));
+        read_image(file, image);
+    }
+}
+
+bool image_source::next(std::vector<unsigned char> &image)
+{
+    raw_image raw;
+    if (!read(raw)) return false;
+    raw.decode(image);
+    return true;
+}
+
+data_uri_source::data_uri_source(std::string uri)
+        : m_uri(std::move(uri)), m_done(false)
+{
+}
+
+bool data_uri_source::read(raw_image &image)
+{
+    if (m_done) return false;
+
+    m_done = true;
+    // The URI is not needed anymore.
+    image.clear();
+    image.text = std::move(m_uri);
+    image.uri = image.text.data();
+    image.uri_size = image.text.size();
+    return true;
+}
+
+file_source::file_source(std::string path)
+        : m_path(std::move(path)), m_done(false)
+{
+}
+
+bool file_source::read(raw_image &image)
+{
+    if (m_done) return false;
+
+    m_done = true;
+    image.clear();
+    image.path = std::move(m_path);
+    return true;
+}
+
+data_uri_stream_source::data_uri_stream_source(std::istream &stream)
+        : m_stream(stream)
+{
+}
+
+bool data_uri_stream_source::read(raw_image &image)
+{
+    image.clear();
+    while (std::getline(m_stream, image.text))
+    {
+        if (!image.text.empty() && image.text.back() == '\r') image.text.pop_back();
+        if (image.text.empty()) continue;
+
+        image.uri = image.text.data();
+        image.uri_size = image.text.size();
+        return true;
+    }
+    return false;
+}
+
+source_chain::source_chain()
+        : m_current(0)
+{
+}
+
+void source_chain::append(std::unique_ptr<image_source> source)
+{
+    m_sources.push_back(std::move(source));
+}
+
+bool source_chain::read(raw_image &image)
+{
+    for (; m_current < m_sources.size(); m_current++)
+    {
+        if (m_sources[m_current]->read(image)) return true;
+        m_sources[m_current].reset();
+    }
+    return false;
+}
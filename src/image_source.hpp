@@ -0,0 +1,192 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file image_source.hpp
+ * \brief An header defining where the images to be analyzed come from.
+ *
+ * This header contains the abstraction yielding, one at a time, the images given through the CLI API.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_IMAGE_SOURCE_HPP
+#define EMOTIONS_IMAGE_SOURCE_HPP
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief An image read from a source, but not decoded yet.
+ *
+ * Reading an image only takes from the source what must be taken in order (e.g. the next line of a file). Decoding
+ * its payload, the expensive part, does not need the source anymore: it can run on any thread, while the following
+ * images are being read.
+ */
+struct raw_image
+{
+    std::string text; ///< The storage of the data URI, if the source does not keep it.
+    const char *uri = nullptr; ///< The data URI of the image (in `text` or kept by the source), if any.
+    std::size_t uri_size = 0; ///< The length of `uri`.
+    std::string path; ///< The file containing the image, if it is not given as a data URI.
+
+    /**
+     * \brief Forget the image.
+     */
+    void clear()
+    {
+        uri = nullptr;
+        uri_size = 0;
+        path.clear();
+    }
+
+    /**
+     * \brief Decode the image.
+     *
+     * \param image A buffer that will contain the decoded image (the bytes of the image file).
+     *
+     * \throws data_uri::string_not_uri if the image is not a valid data URI.
+     */
+    void decode(std::vector<unsigned char> &image) const;
+};
+
+/**
+ * \brief A source of images.
+ *
+ * An image source yields, one at a time and only when requested, the images to be analyzed. The memory it uses is
+ * therefore independent of the number of images. A source is not thread-safe: concurrent consumers must serialize
+ * their calls to read() and next(), but not the decoding of the images they read.
+ */
+class image_source
+{
+public:
+    virtual ~image_source() = default;
+
+    /**
+     * \brief Read the next image, without decoding it.
+     *
+     * \param image A variable that will contain the image. The memory it refers to stays valid as long as the source.
+     * \return True if an image has been read, false if the source is exhausted.
+     */
+    virtual bool read(raw_image &image) = 0;
+
+    /**
+     * \brief Read and decode the next image.
+     *
+     * \param image A buffer that will contain the decoded image (the bytes of the image file).
+     * \return True if an image has been decoded, false if the source is exhausted.
+     *
+     * \throws data_uri::string_not_uri if the next image is not a valid data URI. The image is skipped: the source can
+     *   still be used.
+     */
+    bool next(std::vector<unsigned char> &image);
+};
+
+/**
+ * \brief A data URI given through the CLI API.
+ */
+class data_uri_source : public image_source
+{
+private:
+    std::string m_uri;
+    bool m_done;
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param uri The data URI.
+     */
+    explicit data_uri_source(std::string uri);
+
+    bool read(raw_image &image) override;
+};
+
+/**
+ * \brief A file given through the CLI API.
+ *
+ * The file contains either a data URI, decoded while it is being read, or the raw bytes of an image. The path
+ * ::STDIN_IMAGE reads the standard input. The file is only read when the image is decoded.
+ */
+class file_source : public image_source
+{
+private:
+    std::string m_path;
+    bool m_done;
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param path The path of the file.
+     */
+    explicit file_source(std::string path);
+
+    bool read(raw_image &image) override;
+};
+
+/**
+ * \brief A stream of newline-delimited data URIs.
+ *
+ * Each line is read only when requested, so the stream can be fed continuously (e.g. from a pipe), and parsed and
+ * decoded only with the image. Empty lines are ignored.
+ */
+class data_uri_stream_source : public image_source
+{
+private:
+    std::istream &m_stream;
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param stream The stream to be read.
+     */
+    explicit data_uri_stream_source(std::istream &stream);
+
+    bool read(raw_image &image) override;
+};
+
+/**
+ * \brief A sequence of sources.
+ *
+ * This source yields all the images of its sources, in order.
+ */
+class source_chain : public image_source
+{
+private:
+    std::vector<std::unique_ptr<image_source>> m_sources;
+    std::size_t m_current;
+
+public:
+    source_chain();
+
+    /**
+     * \brief Append a source.
+     *
+     * \param source The source to be appended.
+     */
+    void append(std::unique_ptr<image_source> source);
+
+    bool read(raw_image &image) override;
+};
+
+#endif //EMOTIONS_IMAGE_SOURCE_HPP
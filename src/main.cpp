@@ -27,13 +27,40 @@
  *
  * ```
  * emotions [<option>...] IMAGE...
+ * emotions [<option>...] --file FILE
+ * emotions [<option>...] --stdin
+ * emotions [<option>...] --serve SOCKET
+ * emotions [<option>...] --session
  *
  * <option> := -h | --help
  * ```
  *
  * Using the above CLI (Command Line Interface), the argument IMAGE can be used
  * multiple times. It must represents either a file containing _only_ the \ref
- * data_uri "data URI" of an image or the \ref data_uri "data URI" itself.
+ * data_uri "data URI" of an image, the \ref data_uri "data URI" itself, an
+ * image file (e.g. a JPEG or a PNG) or a directory containing such files. An
+ * IMAGE equal to `-` reads the image from the standard input.
+ *
+ * With `--stdin`, the tool reads newline-delimited \ref data_uri "data URIs"
+ * from the standard input and writes the result of each image, on its own
+ * line, as soon as it is available. It can thus be fed continuously through
+ * a pipe.
+ *
+ * With `--serve`, the tool loads the detector once and keeps analyzing the
+ * images sent over a Unix domain socket by any number of clients (see the
+ * \ref server "server" for the protocol), until it is interrupted.
+ *
+ * With `--session`, the tool reads from the standard input the frames of
+ * webcam sessions, one per line, as the identifier of the session, the
+ * timestamp of the frame (in seconds) and its \ref data_uri "data URI",
+ * separated by tabs. The faces are tracked from a frame to the next one of
+ * the same session, keeping their identifiers. The result of each frame,
+ * along with its session and timestamp, is written as soon as it is
+ * available.
+ *
+ * An image that cannot be decoded or analyzed in time is reported on the
+ * standard error and, in place of its result, yields an object telling why
+ * (`{"error": "..."}`); the analysis goes on with the next images.
  *
  * \section the-project The project
  */
@@ -47,79 +74,324 @@
  *
  * \author Andrea Esposito <[github.com/espositoandrea](https://github.com/espositoandrea)>
  */
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/core/core.hpp>
 #include <opencv/cv.hpp>
 
+#ifdef EMOTIONS_WITH_AFFDEX
 #include <PhotoDetector.h>
-#include <Frame.h>
+#include <FrameDetector.h>
+#endif
 
 #include "common/PlottingImageListener.hpp"
-#include "common/StatusListener.hpp"
 
 #include "exit_codes.hpp"
 #include "utilities.hpp"
-#include "base64.hpp"
+#include "frame_pool.hpp"
+#include "decode_pipeline.hpp"
+#include "emotion_backend.hpp"
+#ifdef EMOTIONS_WITH_AFFDEX
+#include "affdex_backend.hpp"
+#endif
+#include "synthetic_backend.hpp"
+#include "server.hpp"
+#include "worker_pool.hpp"
+#include "manifest.hpp"
+#include "shards.hpp"
+#include "session.hpp"
 
+#ifdef EMOTIONS_WITH_AFFDEX
 /**
- * \brief The main entry point.
+ * \brief The maximum number of faces analyzed in an image.
+ */
+const unsigned int nFaces = 1;
+
+/**
+ * \brief The face detector mode of the detectors.
+ */
+const int faceDetectorMode = (int) affdex::FaceDetectorMode::LARGE_FACES;
+
+/**
+ * \brief The number of frames per second processed in session mode.
  *
- * This is the entry point of the tool.
+ * The detector skips the frames closer than its period to the previous one:
+ * their backend spaces them by at least two periods, so this is much higher
+ * than the rate of any webcam, in order not to alter their time.
+ */
+const float sessionFrameRate = 1000;
+
+/**
+ * \brief Configure a detector for the analysis.
  *
- * \param argc The length of `argv`.
- * \param argv The array of arguments given through the command line.
- * \return An \ref exit_codes "exit code" based on the execution.
+ * \param detector The detector, not yet started.
+ * \param classifiers The classifiers to be enabled.
  */
-int main(int argc, char **argv)
+void configure_detector(affdex::Detector &detector, const classifier_set &classifiers)
 {
-    std::vector <std::string> images;
-    const exit_codes result = setup_options(argc, argv, images);
-    if (result != exit_codes::OK) return static_cast<int>(result);
+    detector.setDetectAllEmotions(classifiers.emotions);
+    detector.setDetectAllExpressions(classifiers.expressions);
+    detector.setDetectAllEmojis(classifiers.emojis);
+    detector.setDetectAllAppearances(classifiers.appearances);
+    detector.setClassifierPath(affdex::path("lib/affdex-sdk/data/"));
+}
+#endif
 
-    const unsigned int nFaces = 1;
-    const int faceDetectorMode = (int) affdex::FaceDetectorMode::LARGE_FACES;
+/**
+ * \brief Create the backend analyzing the images.
+ *
+ * \param config The settings of the tool.
+ * \param sessions Whether the backend tracks the faces from a frame to the next one.
+ * \return The backend, ready to analyze the images.
+ */
+std::unique_ptr<emotion_backend> make_backend(const settings &config, bool sessions)
+{
+    if (config.synthetic)
+    {
+        return std::unique_ptr<emotion_backend>(new synthetic_backend(config.synthetic_latency,
+                                                                      config.synthetic_jitter));
+    }
+#ifdef EMOTIONS_WITH_AFFDEX
+    if (sessions)
+    {
+        std::unique_ptr<affdex::FrameDetector> detector(
+                new affdex::FrameDetector(1, sessionFrameRate, nFaces, (affdex::FaceDetectorMode) faceDetectorMode));
+        configure_detector(*detector, config.classifiers);
+        return std::unique_ptr<emotion_backend>(new affdex_backend(std::move(detector), sessionFrameRate));
+    }
+    std::unique_ptr<affdex::PhotoDetector> detector(new affdex::PhotoDetector(nFaces,
+                                                                              (affdex::FaceDetectorMode) faceDetectorMode));
+    configure_detector(*detector, config.classifiers);
+    return std::unique_ptr<emotion_backend>(new affdex_backend(std::move(detector)));
+#else
+    // Without the SDK, setup_options() only accepts the synthetic backend.
+    throw std::logic_error("The tool has been built without the Affdex SDK");
+#endif
+}
 
-    std::shared_ptr <affdex::Detector> detector = std::make_shared<affdex::PhotoDetector>(nFaces,
-                                                                                          (affdex::FaceDetectorMode) faceDetectorMode);
+/**
+ * \brief Create the backends of the workers.
+ *
+ * \param config The settings of the tool.
+ * \param backends A vector that will contain the backends.
+ * \return The backends of the workers.
+ */
+std::vector<emotion_backend *> start_workers(const settings &config,
+                                             std::vector<std::unique_ptr<emotion_backend>> &backends)
+{
+    // Each worker has its own backend (and, with the SDK, its own detector).
+    std::vector<emotion_backend *> workers;
+    for (std::size_t i = 0; i < config.workers; i++)
+    {
+        backends.push_back(make_backend(config, false));
+        workers.push_back(backends.back().get());
+    }
+    return workers;
+}
 
-    std::shared_ptr <PlottingImageListener> listenPtr(new PlottingImageListener());
+/**
+ * \brief Report how close a backend came to its limits.
+ *
+ * This function warns, on the standard error, if the events of a detector
+ * filled their ring, i.e. if the detector waited for its backend.
+ *
+ * \param backend The backend, done analyzing the images.
+ */
+void report_usage(const emotion_backend &backend)
+{
+#ifdef EMOTIONS_WITH_AFFDEX
+    const auto *detector = dynamic_cast<const affdex_backend *>(&backend);
+    if (detector && detector->events_high_water_mark() >= detector->events_capacity())
+    {
+        std::cerr << "WARNING: The events of a detector filled their ring (" << detector->events_capacity()
+                  << " events): the detector waited for its backend" << std::endl;
+    }
+#else
+    static_cast<void>(backend);
+#endif
+}
 
-    detector->setDetectAllEmotions(true);
-    detector->setDetectAllExpressions(true);
-    detector->setDetectAllEmojis(true);
-    detector->setDetectAllAppearances(true);
-    detector->setClassifierPath(affdex::path("lib/affdex-sdk/data/"));
-    detector->setImageListener(listenPtr.get());
+/**
+ * \brief Analyze all the images of a source.
+ *
+ * \param source The source of the images.
+ * \param config The settings of the tool.
+ * \param results The listener receiving the results, in the order of the images.
+ */
+void analyze_images(image_source &source, const settings &config, PlottingImageListener &results)
+{
+    std::vector<std::unique_ptr<emotion_backend>> backends;
+    const std::vector<emotion_backend *> workers = start_workers(config, backends);
 
-    detector->start();
+    frame_pool pool;
+    decode_pipeline images(source, config.limits, pool, config.decode_threads,
+                           std::max(config.prefetch, config.workers));
+    // While the detectors analyze some images, the next ones are being decoded.
+    worker_pool(workers, config.timeout).run(images, pool, [&results](const analysis *found, const std::string &error)
+    {
+        if (found) results.addResult(found->faces);
+        else results.addError(error);
+    });
+    for (const auto &backend : backends) report_usage(*backend);
+}
 
-    std::shared_ptr <StatusListener> videoListenPtr = std::make_shared<StatusListener>();
-    detector->setProcessStatusListener(videoListenPtr.get());
+/**
+ * \brief Analyze the frames of the sessions read from a stream.
+ *
+ * A single backend tracks the faces from a frame to the next one of the same
+ * session, and is reset when a new session begins.
+ *
+ * \param in The stream containing the frames (see session_reader).
+ * \param config The settings of the tool.
+ * \param results The listener receiving the results, in the order of the frames.
+ */
+void analyze_sessions(std::istream &in, const settings &config, PlottingImageListener &results)
+{
+    const std::unique_ptr<emotion_backend> frames = make_backend(config, true);
 
-    for (const auto &image : images)
+    frame_pool pool;
+    session_reader sessions(in);
+    session_frame frame;
+    std::string current;
+    bool started = false;
+    double origin = 0;
+    double last = 0;
+    while (true)
     {
-        std::string decoded = base64::decode(image);
-        cv::Mat img = cv::imdecode(std::vector<uchar>(decoded.begin(), decoded.end()), cv::IMREAD_UNCHANGED);
-
-        affdex::Frame frame(img.size().width, img.size().height, img.data, affdex::Frame::COLOR_FORMAT::BGR);
+        try
+        {
+            if (!sessions.next(frame)) break;
+        }
+        catch (session_reader::invalid_frame &e)
+        {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            results.addError(e.what());
+            continue;
+        }
+        catch (data_uri::string_not_uri &e)
+        {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            results.addError(frame.session, e.what(), frame.timestamp);
+            continue;
+        }
 
-        ((affdex::PhotoDetector *) detector.get())->process(frame); //Process an image
+        if (!started || frame.session != current)
+        {
+            // The faces of the previous session are not tracked anymore.
+            if (started) frames->reset();
+            current = frame.session;
+            started = true;
+            origin = frame.timestamp;
+        }
+        else if (frame.timestamp <= last)
+        {
+            const std::string error = "The frames of a session must be ordered by time";
+            std::cerr << "ERROR: " << error << std::endl;
+            results.addError(frame.session, error, frame.timestamp);
+            continue;
+        }
+        last = frame.timestamp;
 
-        do
+        cv::Mat pixels;
+        try
         {
-            if (listenPtr->getDataSize() > 0)
+            pixels = decode_image(frame.image, config.limits, pool);
+            if (pixels.empty())
             {
-                std::pair <Frame, std::map<FaceId, Face>> dataPoint = listenPtr->getData();
-                affdex::Frame frame = dataPoint.first;
-                std::map <FaceId, Face> faces = dataPoint.second;
-
-                listenPtr->addResult(faces, frame.getTimestamp());
+                const std::string error = "Unable to decode an image";
+                std::cerr << "ERROR: " << error << std::endl;
+                results.addError(frame.session, error, frame.timestamp);
+                continue;
             }
-        } while ((videoListenPtr->isRunning() || listenPtr->getDataSize() > 0));
+
+            const image_frame::color_format format = frame_format(pixels, pool);
+            // A float cannot hold the timestamps since the epoch: the detector gets the time since the session started.
+            const image_frame image = make_frame(pixels, format, static_cast<float>(frame.timestamp - origin));
+            const analysis found = frames->analyze(image, config.timeout);
+            results.addResult(frame.session, found.faces, frame.timestamp);
+        }
+        catch (emotion_backend::timed_out &e)
+        {
+            // The detector may still be reading the pixels: the frame keeps them, out of the pool.
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            results.addError(frame.session, e.what(), frame.timestamp);
+            continue;
+        }
+        catch (std::exception &e)
+        {
+            // e.g. a cv::Exception, std::bad_alloc or an affdex::AffdexException: only this frame is skipped.
+            std::cerr << "Encountered an exception while processing: " << e.what() << std::endl;
+            results.addError(frame.session, e.what(), frame.timestamp);
+        }
+        pool.release(pixels);
+    }
+    report_usage(*frames);
+}
+
+/**
+ * \brief The main entry point.
+ *
+ * This is the entry point of the tool.
+ *
+ * \param argc The length of `argv`.
+ * \param argv The array of arguments given through the command line.
+ * \return An \ref exit_codes "exit code" based on the execution.
+ */
+int main(int argc, char **argv)
+{
+    settings config;
+    const exit_codes result = setup_options(argc, argv, config);
+    if (result != exit_codes::OK) return static_cast<int>(result);
+
+    if (config.shards > 1)
+    {
+        // Each shard is analyzed by its own process: the processes are
+        // forked before any detector (or thread) is started.
+        const bool analyzed = run_shards(config.shards, [&config](std::size_t shard, std::ostream &out)
+        {
+            manifest images(config.file, shard, config.shards);
+            PlottingImageListener results;
+            results.setClassifiers(config.classifiers);
+            // The shards are merged once they are done: their results are only
+            // written when the buffer is full.
+            results.streamTo(out, 0);
+            analyze_images(images, config, results);
+            results.outputToFile(out);
+        }, std::cout);
+        return static_cast<int>(analyzed ? exit_codes::OK : exit_codes::SHARD_ERROR);
     }
 
+    std::shared_ptr <PlottingImageListener> listenPtr(new PlottingImageListener());
+    listenPtr->setClassifiers(config.classifiers);
+    if (config.stream_results) listenPtr->streamTo(std::cout, config.flush_every);
+
+    if (!config.serve_path.empty())
+    {
+        std::vector<std::unique_ptr<emotion_backend>> backends;
+        const std::vector<emotion_backend *> workers = start_workers(config, backends);
+        try
+        {
+            server daemon(config.serve_path, workers, *listenPtr, config.limits, config.timeout);
+            daemon.run();
+            for (const auto &backend : backends) report_usage(*backend);
+        }
+        catch (boost::system::system_error &e)
+        {
+            std::cerr << "ERROR: Unable to listen on '" << config.serve_path << "': " << e.what() << std::endl;
+            return static_cast<int>(exit_codes::SERVER_ERROR);
+        }
+        return 0;
+    }
+
+    if (config.sessions) analyze_sessions(std::cin, config, *listenPtr);
+    else analyze_images(*config.images, config, *listenPtr);
+
     listenPtr->outputToFile(std::cout);
     return 0;
 }
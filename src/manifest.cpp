@@ -0,0 +1,83 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file manifest.cpp
+ * \brief Implementation of manifest.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "manifest.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/filesystem.hpp>
+
+manifest::manifest(const std::string &path)
+        : m_position(nullptr), m_end(nullptr)
+{
+    // Empty files cannot be mapped.
+    if (boost::filesystem::file_size(path) == 0) return;
+
+    m_file.open(path);
+    m_position = m_file.data();
+    m_end = m_position + m_file.size();
+}
+
+manifest::manifest(const std::string &path, std::size_t shard, std::size_t shards)
+        : manifest(path)
+{
+    const std::size_t size = m_end - m_position;
+    const char *begin = line_at(size * shard / shards);
+    m_end = line_at(size * (shard + 1) / shards);
+    m_position = begin;
+}
+
+const char *manifest::line_at(std::size_t offset) const
+{
+    const char *data = m_file.is_open() ? m_file.data() : nullptr;
+    const std::size_t size = m_file.is_open() ? m_file.size() : 0;
+    if (offset == 0 || offset >= size) return data + std::min(offset, size);
+
+    // A line starts right after a newline.
+    const char *newline = static_cast<const char *>(std::memchr(data + offset - 1, '\n', size - offset + 1));
+    return newline ? newline + 1 : data + size;
+}
+
+bool manifest::read(raw_image &image)
+{
+    while (m_position < m_end)
+    {
+        const char *line = m_position;
+        const char *newline = static_cast<const char *>(std::memchr(line, '\n', m_end - line));
+        const char *end = newline ? newline : m_end;
+        m_position = newline ? newline + 1 : m_end;
+
+        if (end > line && end[-1] == '\r') end--;
+        if (end == line) continue;
+
+        image.clear();
+        image.uri = line;
+        image.uri_size = end - line;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,100 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file manifest.hpp
+ * \brief An header to read the files given through `--file`.
+ *
+ * This header contains the declaration of the class reading, one line at a time, a file of data URIs.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_MANIFEST_HPP
+#define EMOTIONS_MANIFEST_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "image_source.hpp"
+
+/**
+ * \brief A file containing a data URI per line.
+ *
+ * This class memory-maps a file containing a \ref data_uri "data URI" per line. Lines are found with `memchr` and
+ * each one is parsed and decoded only when it is requested, so the memory used does not depend on the size of the
+ * file but only on the size of the image being decoded.
+ */
+class manifest : public image_source
+{
+private:
+    boost::iostreams::mapped_file_source m_file;
+    const char *m_position;
+    const char *m_end;
+
+    /**
+     * \brief Find the first line starting at or after an offset.
+     *
+     * \param offset The offset in the file.
+     * \return The beginning of the line, or the end of the file if there is no such line.
+     */
+    const char *line_at(std::size_t offset) const;
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * This constructor maps a file in memory.
+     *
+     * \param path The path of the file.
+     *
+     * \throws std::ios_base::failure if the file cannot be mapped.
+     */
+    explicit manifest(const std::string &path);
+
+    /**
+     * \brief Construct a shard of a file.
+     *
+     * This constructor maps a file in memory, reading only the lines of one of its shards. The file is split in
+     * shards of about the same size, each one moved forward to the beginning of a line: each line belongs to exactly
+     * one shard.
+     *
+     * \param path The path of the file.
+     * \param shard The shard to be read, from 0 to `shards - 1`.
+     * \param shards The number of shards.
+     *
+     * \throws std::ios_base::failure if the file cannot be mapped.
+     */
+    manifest(const std::string &path, std::size_t shard, std::size_t shards);
+
+    /**
+     * \brief Read the next image.
+     *
+     * This function finds the next non-empty line of the file. The image refers to the mapped file: nothing is copied.
+     *
+     * \param image A variable that will contain the image.
+     * \return True if an image has been read, false if the end of the file has been reached.
+     */
+    bool read(raw_image &image) override;
+};
+
+#endif //EMOTIONS_MANIFEST_HPP
@@ -0,0 +1,67 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file result_writer.cpp
+ * \brief Implementation of result_writer.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "result_writer.hpp"
+
+const std::size_t result_writer::DEFAULT_BUFFER_SIZE;
+
+// The buffer has room for the result crossing its size, so that it is (almost) never reallocated.
+result_writer::result_writer(std::ostream &out, std::size_t flush_every, std::size_t buffer_size)
+        : m_out(out), m_flush_every(flush_every), m_buffer_size(buffer_size),
+          m_buffer(nullptr, buffer_size + buffer_size / 4), m_writer(m_buffer), m_pending(0)
+{
+}
+
+result_writer::~result_writer()
+{
+    flush();
+}
+
+result_writer::json_writer &result_writer::begin()
+{
+    // Each line is a new JSON document.
+    m_writer.Reset(m_buffer);
+    return m_writer;
+}
+
+void result_writer::end()
+{
+    m_buffer.Put('\n');
+    m_pending++;
+    if ((m_flush_every && m_pending >= m_flush_every) || m_buffer.GetSize() >= m_buffer_size) flush();
+}
+
+void result_writer::flush()
+{
+    if (m_buffer.GetSize())
+    {
+        m_out.write(m_buffer.GetString(), m_buffer.GetSize());
+        // The capacity is kept for the next results.
+        m_buffer.Clear();
+    }
+    m_out.flush();
+    m_pending = 0;
+}
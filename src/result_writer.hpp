@@ -0,0 +1,107 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file result_writer.hpp
+ * \brief An header to stream the results as they are available.
+ *
+ * This header contains the writer serializing the results one per line (NDJSON) into a reusable buffer.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_RESULT_WRITER_HPP
+#define EMOTIONS_RESULT_WRITER_HPP
+
+#include <cstddef>
+#include <ostream>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+/**
+ * \brief A writer of newline-delimited results.
+ *
+ * Each result is serialized through a single `rapidjson::Writer` into a buffer allocated once and reused: the buffer
+ * is written to the stream (and the stream flushed) every given number of results, or as soon as it exceeds its size.
+ * Results are written whole: a crash only loses the ones still in the buffer.
+ */
+class result_writer
+{
+public:
+    /**
+     * \brief The writer of a result.
+     */
+    typedef rapidjson::Writer<rapidjson::StringBuffer> json_writer;
+
+    /**
+     * \brief The size of the buffer used by default.
+     */
+    static const std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+private:
+    std::ostream &m_out;
+    const std::size_t m_flush_every;
+    const std::size_t m_buffer_size;
+    rapidjson::StringBuffer m_buffer;
+    json_writer m_writer;
+    std::size_t m_pending;
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param out The stream the results are written to.
+     * \param flush_every The number of results written between two flushes, or 0 to flush only when the buffer is
+     * full.
+     * \param buffer_size The size above which the buffer is flushed anyway.
+     */
+    explicit result_writer(std::ostream &out, std::size_t flush_every = 1,
+                           std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * \brief The class destructor.
+     *
+     * The results still in the buffer are flushed.
+     */
+    ~result_writer();
+
+    result_writer(const result_writer &) = delete;
+
+    result_writer &operator=(const result_writer &) = delete;
+
+    /**
+     * \brief Begin a result.
+     *
+     * \return The writer the result (a single JSON value) must be written to before calling end().
+     */
+    json_writer &begin();
+
+    /**
+     * \brief End the result begun by begin(), flushing the buffer if it is time to.
+     */
+    void end();
+
+    /**
+     * \brief Write the buffered results to the stream, and flush it.
+     */
+    void flush();
+};
+
+#endif //EMOTIONS_RESULT_WRITER_HPP
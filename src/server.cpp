@@ -0,0 +1,231 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file server.cpp
+ * \brief Implementation of server.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "server.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include "data_uri.hpp"
+#include "utilities.hpp"
+
+const std::uint32_t server::MAX_REQUEST_SIZE = 64u << 20u;
+
+const std::size_t server::MAX_CLIENTS = 64;
+
+namespace
+{
+    /**
+     * \brief Send a response to a client.
+     *
+     * \param socket The connection with the client.
+     * \param response The JSON response.
+     */
+    void write_response(boost::asio::local::stream_protocol::socket &socket, const std::string &response)
+    {
+        const std::size_t size = response.size();
+        const unsigned char header[4] = {static_cast<unsigned char>(size >> 24u),
+                                         static_cast<unsigned char>(size >> 16u),
+                                         static_cast<unsigned char>(size >> 8u),
+                                         static_cast<unsigned char>(size)};
+        const std::vector<boost::asio::const_buffer> buffers{boost::asio::buffer(header),
+                                                             boost::asio::buffer(response)};
+        boost::asio::write(socket, buffers);
+    }
+}
+
+server::server(const std::string &path, std::vector<emotion_backend *> backends, const PlottingImageListener &results,
+               const decode_limits &limits, std::chrono::milliseconds timeout)
+        : m_path(path), m_backends(std::move(backends)), m_turn(0), m_results(results), m_limits(limits),
+          m_timeout(timeout), m_acceptor(m_io),
+          m_signals(m_io, SIGINT, SIGTERM), m_accepting(true)
+{
+    // A socket left by a previous run would make bind() fail.
+    std::remove(m_path.c_str());
+
+    const protocol::endpoint endpoint(m_path);
+    m_acceptor.open(endpoint.protocol());
+    m_acceptor.bind(endpoint);
+    m_acceptor.listen();
+}
+
+server::~server()
+{
+    std::remove(m_path.c_str());
+}
+
+void server::run()
+{
+    m_signals.async_wait([this](const boost::system::error_code &, int)
+                         {
+                             m_acceptor.close();
+                         });
+    accept();
+    m_io.run();
+
+    {
+        std::lock_guard<std::mutex> lock(m_clients_mutex);
+        boost::system::error_code ignored;
+        for (auto client : m_clients) client->shutdown(protocol::socket::shutdown_both, ignored);
+    }
+    for (auto &thread : m_threads) thread.join();
+}
+
+void server::accept()
+{
+    // The server may have stopped while no client was being accepted.
+    if (!m_acceptor.is_open()) return;
+
+    m_acceptor.async_accept([this](const boost::system::error_code &error, protocol::socket socket)
+                            {
+                                if (error)
+                                {
+                                    // The acceptor has been closed: stop serving.
+                                    if (error == boost::asio::error::operation_aborted) m_signals.cancel();
+                                    else accept();
+                                    return;
+                                }
+
+                                auto client = std::make_shared<protocol::socket>(std::move(socket));
+                                bool full;
+                                {
+                                    std::lock_guard<std::mutex> lock(m_clients_mutex);
+                                    m_clients.insert(client.get());
+                                    // The next client waits (in the backlog of the socket) for one to leave.
+                                    full = m_clients.size() >= MAX_CLIENTS;
+                                    m_accepting = !full;
+
+                                    // Join the threads of the clients gone in the meantime.
+                                    for (auto &id : m_finished)
+                                    {
+                                        for (auto it = m_threads.begin(); it != m_threads.end(); ++it)
+                                        {
+                                            if (it->get_id() != id) continue;
+                                            it->join();
+                                            m_threads.erase(it);
+                                            break;
+                                        }
+                                    }
+                                    m_finished.clear();
+                                }
+                                m_threads.emplace_back([this, client]()
+                                                       {
+                                                           serve(*client);
+                                                           std::lock_guard<std::mutex> lock(m_clients_mutex);
+                                                           m_clients.erase(client.get());
+                                                           m_finished.push_back(std::this_thread::get_id());
+                                                           if (!m_accepting)
+                                                           {
+                                                               m_accepting = true;
+                                                               boost::asio::post(m_io, [this]() { accept(); });
+                                                           }
+                                                       });
+                                if (!full) accept();
+                            });
+}
+
+void server::serve(protocol::socket &socket)
+{
+    std::vector<unsigned char> image, buffer;
+    try
+    {
+        while (true)
+        {
+            unsigned char header[4];
+            boost::asio::read(socket, boost::asio::buffer(header));
+            const std::uint32_t size = (std::uint32_t(header[0]) << 24u) | (std::uint32_t(header[1]) << 16u) |
+                                       (std::uint32_t(header[2]) << 8u) | std::uint32_t(header[3]);
+            if (size > MAX_REQUEST_SIZE)
+            {
+                // The request cannot be skipped safely: answer and hang up.
+                write_response(socket, PlottingImageListener::formatError("The image is too large"));
+                return;
+            }
+
+            image.resize(size);
+            boost::asio::read(socket, boost::asio::buffer(image));
+            write_response(socket, analyze(image, buffer));
+        }
+    }
+    catch (boost::system::system_error &)
+    {
+        // The client has closed the connection (or the server is stopping).
+    }
+    catch (std::exception &e)
+    {
+        // Any other failure (e.g. std::bad_alloc for the request) only hangs up on this client.
+        try
+        {
+            write_response(socket, PlottingImageListener::formatError(e.what()));
+        }
+        catch (boost::system::system_error &)
+        {
+        }
+    }
+}
+
+std::string server::analyze(const std::vector<unsigned char> &image, std::vector<unsigned char> &buffer)
+{
+    cv::Mat pixels;
+    try
+    {
+        // Image files are decoded in place, data URIs into the buffer.
+        const char *data = reinterpret_cast<const char *>(image.data());
+        const bool uri = data_uri_view::is_data_uri(data, image.size());
+        if (uri) decode_data_uri(data_uri_view(data, image.size()), buffer);
+
+        pixels = decode_image(uri ? buffer : image, m_limits, m_pool);
+        if (pixels.empty()) return PlottingImageListener::formatError("Unable to decode an image");
+
+        const image_frame::color_format format = frame_format(pixels, m_pool);
+        const image_frame frame = make_frame(pixels, format);
+
+        emotion_backend &detector = *m_backends[m_turn++ % m_backends.size()];
+        const analysis found = detector.analyze(frame, m_timeout);
+
+        const std::string response = m_results.formatResult(found.faces);
+        // The detector is done with the pixels.
+        m_pool.release(pixels);
+        return response;
+    }
+    catch (emotion_backend::timed_out &e)
+    {
+        // The detector may still be reading the pixels: the frame keeps them, out of the pool.
+        return PlottingImageListener::formatError(e.what());
+    }
+    catch (std::exception &e)
+    {
+        // Whatever went wrong (e.g. an invalid data URI, a cv::Exception, std::bad_alloc or an
+        // affdex::AffdexException), only this request fails.
+        m_pool.release(pixels);
+        return PlottingImageListener::formatError(e.what());
+    }
+}
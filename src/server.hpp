@@ -0,0 +1,150 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file server.hpp
+ * \brief An header to serve the analysis over a Unix domain socket.
+ *
+ * This header contains the server keeping the detector running between the requests of many clients.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_SERVER_HPP
+#define EMOTIONS_SERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "emotion_backend.hpp"
+#include "frame_pool.hpp"
+#include "image_decoder.hpp"
+#include "common/PlottingImageListener.hpp"
+
+/**
+ * \brief A server analyzing the images sent over a Unix domain socket.
+ *
+ * Each client can send any number of requests on its connection. A request is the length of the image, as a 4 bytes
+ * big-endian unsigned integer, followed by the image itself (either a \ref data_uri "data URI" or the bytes of an
+ * image file). Each request gets a response, in the same order: the length of a JSON object, as a 4 bytes big-endian
+ * unsigned integer, followed by the JSON object itself. The object is the result of the image or, if the image could
+ * not be analyzed, an object whose `error` member describes why.
+ *
+ * Each client is served by its own thread, decoding its images. The images are handed to the detectors in turn, each
+ * detector analyzing one image at a time. At most MAX_CLIENTS clients are served at the same time: the following ones
+ * are only accepted once a client leaves.
+ */
+class server
+{
+private:
+    using protocol = boost::asio::local::stream_protocol;
+
+    const std::string m_path;
+    const std::vector<emotion_backend *> m_backends;
+    std::atomic<std::size_t> m_turn;
+    const PlottingImageListener &m_results;
+    const decode_limits m_limits;
+    const std::chrono::milliseconds m_timeout;
+    frame_pool m_pool;
+
+    boost::asio::io_context m_io;
+    protocol::acceptor m_acceptor;
+    boost::asio::signal_set m_signals;
+
+    std::mutex m_clients_mutex;
+    std::set<protocol::socket *> m_clients;
+    std::list<std::thread> m_threads;
+    std::vector<std::thread::id> m_finished;
+    bool m_accepting;
+
+    /**
+     * \brief Accept the next client.
+     *
+     * Once MAX_CLIENTS clients are being served, no client is accepted until one of them leaves.
+     */
+    void accept();
+
+    /**
+     * \brief Serve a client until it closes the connection.
+     *
+     * \param socket The connection with the client.
+     */
+    void serve(protocol::socket &socket);
+
+    /**
+     * \brief Analyze an image.
+     *
+     * \param image The image (either a data URI or the bytes of an image file).
+     * \param buffer A buffer for the decoded image.
+     * \return The JSON response: the result of the image, or the error if anything went wrong.
+     */
+    std::string analyze(const std::vector<unsigned char> &image, std::vector<unsigned char> &buffer);
+
+public:
+    /**
+     * \brief The largest image accepted.
+     */
+    static const std::uint32_t MAX_REQUEST_SIZE;
+
+    /**
+     * \brief The maximum number of clients served at the same time.
+     */
+    static const std::size_t MAX_CLIENTS;
+
+    /**
+     * \brief The class constructor.
+     *
+     * This constructor binds the socket, replacing any file already at the given path.
+     *
+     * \param path The path of the socket.
+     * \param backends The backends analyzing the images.
+     * \param results The formatter of the results.
+     * \param limits The limits on the size of the decoded images.
+     * \param timeout The maximum time to analyze an image, or 0 to wait as long as needed.
+     */
+    server(const std::string &path, std::vector<emotion_backend *> backends, const PlottingImageListener &results,
+           const decode_limits &limits, std::chrono::milliseconds timeout);
+
+    /**
+     * \brief The class destructor.
+     *
+     * This destructor removes the socket.
+     */
+    ~server();
+
+    /**
+     * \brief Serve the clients.
+     *
+     * This function returns when the process receives either `SIGINT` or `SIGTERM`, after every client has been
+     * disconnected.
+     */
+    void run();
+};
+
+#endif //EMOTIONS_SERVER_HPP
@@ -0,0 +1,68 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file session.cpp
+ * \brief Implementation of session.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "session.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+#include "data_uri.hpp"
+#include "utilities.hpp"
+
+const char *session_reader::invalid_frame::what() const noexcept
+{
+    return "The line is not a frame (SESSION<tab>TIMESTAMP<tab>DATA_URI)";
+}
+
+session_reader::session_reader(std::istream &in) : m_in(in)
+{
+}
+
+bool session_reader::next(session_frame &frame)
+{
+    while (std::getline(m_in, m_line))
+    {
+        if (!m_line.empty() && m_line.back() == '\r') m_line.pop_back();
+        if (m_line.empty()) continue;
+
+        const std::size_t first = m_line.find('\t');
+        if (first == std::string::npos) throw invalid_frame();
+        frame.session.assign(m_line, 0, first);
+        const std::size_t second = m_line.find('\t', first + 1);
+        if (second == std::string::npos) throw invalid_frame();
+
+        const std::string timestamp = m_line.substr(first + 1, second - first - 1);
+        char *end;
+        errno = 0;
+        frame.timestamp = std::strtod(timestamp.c_str(), &end);
+        if (timestamp.empty() || *end != '\0' || errno || !std::isfinite(frame.timestamp)) throw invalid_frame();
+
+        decode_data_uri(data_uri_view(m_line.data() + second + 1, m_line.size() - second - 1), frame.image);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,94 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file session.hpp
+ * \brief An header to read the frames of the sessions given through `--session`.
+ *
+ * This header contains the reader of timestamped frames, grouped by session.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_SESSION_HPP
+#define EMOTIONS_SESSION_HPP
+
+#include <exception>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief A frame of a session.
+ */
+struct session_frame
+{
+    std::string session; ///< The identifier of the session.
+    double timestamp; ///< The time of the frame, in seconds (e.g. since the epoch).
+    std::vector<unsigned char> image; ///< The decoded image.
+};
+
+/**
+ * \brief A reader of the frames of the sessions.
+ *
+ * This class reads, one line at a time, a stream whose non-empty lines are made of three fields separated by a tab:
+ * the identifier of a session, the timestamp of the frame (in seconds) and the \ref data_uri "data URI" of the frame.
+ * The frames of a session are expected to be contiguous and ordered by time.
+ */
+class session_reader
+{
+private:
+    std::istream &m_in;
+    std::string m_line;
+
+public:
+    /**
+     * \brief An exception raised if a line is not a frame.
+     *
+     * This exception is thrown if a line has not three fields, or if its timestamp is not a number.
+     */
+    class invalid_frame : public std::exception
+    {
+    public:
+        const char *what() const noexcept override;
+    };
+
+    /**
+     * \brief The class constructor.
+     *
+     * \param in The stream to be read.
+     */
+    explicit session_reader(std::istream &in);
+
+    /**
+     * \brief Read the next frame.
+     *
+     * The reader stays usable if an exception is thrown: the next call reads the next line. The fields read before
+     * the error (the session first, then the timestamp) are already stored in `frame`.
+     *
+     * \param frame A variable that will contain the frame.
+     * \return True if a frame has been read, false if the end of the stream has been reached.
+     *
+     * \throws invalid_frame if the line is not a frame.
+     * \throws data_uri::string_not_uri if the data URI is not valid.
+     */
+    bool next(session_frame &frame);
+};
+
+#endif //EMOTIONS_SESSION_HPP
@@ -0,0 +1,116 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file shards.cpp
+ * \brief Implementation of shards.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "shards.hpp"
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+
+bool run_shards(std::size_t shards, const shard_worker &worker, std::ostream &out)
+{
+    std::vector<std::string> paths;
+    std::vector<pid_t> children;
+    bool success = true;
+
+    // Anything buffered would be written again by each child.
+    std::cout.flush();
+    std::cerr.flush();
+
+    for (std::size_t shard = 0; shard < shards && success; shard++)
+    {
+        paths.push_back((boost::filesystem::temp_directory_path() /
+                         boost::filesystem::unique_path("emotions-%%%%-%%%%-%%%%.ndjson")).string());
+
+        const pid_t child = fork();
+        if (child < 0)
+        {
+            std::cerr << "ERROR: Unable to start the process of shard " << shard << std::endl;
+            success = false;
+        }
+        else if (child == 0)
+        {
+            int status = 0;
+            try
+            {
+                std::ofstream results(paths.back());
+                worker(shard, results);
+                results.close();
+                if (!results) status = 1;
+            }
+            catch (std::exception &e)
+            {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+                status = 1;
+            }
+            // The child must not run the cleanup of the parent.
+            std::cerr.flush();
+            _exit(status);
+        }
+        else
+        {
+            children.push_back(child);
+        }
+    }
+
+    for (pid_t child : children)
+    {
+        int status;
+        if (waitpid(child, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) success = false;
+    }
+
+    if (success) merge_results(paths, out);
+
+    boost::system::error_code ignored;
+    for (const auto &path : paths) boost::filesystem::remove(path, ignored);
+    return success;
+}
+
+void merge_results(const std::vector<std::string> &paths, std::ostream &out)
+{
+    bool first = true;
+    std::string line;
+
+    out << '[';
+    for (const auto &path : paths)
+    {
+        std::ifstream results(path);
+        while (std::getline(results, line))
+        {
+            if (line.empty()) continue;
+            if (!first) out << ',';
+            out << line;
+            first = false;
+        }
+    }
+    out << ']' << std::endl;
+}
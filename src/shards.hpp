@@ -0,0 +1,72 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file shards.hpp
+ * \brief An header to analyze a file on several processes.
+ *
+ * This header contains the functions splitting the analysis of a file among forked processes and merging their
+ * results.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_SHARDS_HPP
+#define EMOTIONS_SHARDS_HPP
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief The function analyzing a shard.
+ *
+ * The function is called in the process of the shard. It receives the shard to be analyzed (from 0 to the number
+ * of shards - 1) and the stream to write its results to, as a JSON object per line.
+ */
+using shard_worker = std::function<void(std::size_t, std::ostream &)>;
+
+/**
+ * \brief Analyze the shards on forked processes.
+ *
+ * This function forks a process per shard, each one writing its results to a temporary file, and waits for all of
+ * them. If every process succeeds, the results are merged (see merge_results()). The function must be called before
+ * any thread is started.
+ *
+ * \param shards The number of shards.
+ * \param worker The function analyzing a shard.
+ * \param out The stream receiving the merged results.
+ * \return True if every shard has been analyzed, false otherwise.
+ */
+bool run_shards(std::size_t shards, const shard_worker &worker, std::ostream &out);
+
+/**
+ * \brief Merge the results of the shards.
+ *
+ * This function writes a JSON array containing the results (a JSON object per line) of each file, in order. The
+ * array is the same as if all the images were analyzed by a single process.
+ *
+ * \param paths The files containing the results of the shards, in order.
+ * \param out The stream receiving the merged results.
+ */
+void merge_results(const std::vector<std::string> &paths, std::ostream &out);
+
+#endif //EMOTIONS_SHARDS_HPP
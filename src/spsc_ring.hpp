@@ -0,0 +1,286 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file spsc_ring.hpp
+ * \brief An header containing a lock-free queue between two threads.
+ *
+ * This header contains a bounded, lock-free, single-producer/single-consumer ring buffer.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_SPSC_RING_HPP
+#define EMOTIONS_SPSC_RING_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * \brief A bounded queue between a producer and a consumer thread.
+ *
+ * This class is a lock-free ring buffer: one thread at a time may push and one thread at a time may pop. Either side
+ * can poll the queue, or sleep until it can go on: the producer while the queue is full, the consumer while it is
+ * empty. Only if the other side is sleeping, a push or a pop briefly takes a lock, to wake it up.
+ *
+ * \tparam T The type of the values. Values are moved in and out of the queue, and destroyed as soon as they are
+ * popped.
+ */
+template<typename T>
+class spsc_ring
+{
+private:
+    using slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    // The indices are only ever incremented: the slot of an index is index & m_mask.
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<slot[]> m_slots;
+
+    // Producer and consumer write their own index, each one on its own cache line.
+    alignas(64) std::atomic<std::size_t> m_head;
+    alignas(64) std::atomic<std::size_t> m_tail;
+    std::atomic<std::size_t> m_high_water_mark;
+
+    alignas(64) std::atomic<bool> m_consumer_waiting;
+    std::atomic<bool> m_producer_waiting;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::condition_variable m_space;
+    bool m_interrupted;
+
+    /**
+     * \brief Round a capacity up to a power of 2.
+     *
+     * \param capacity The requested capacity.
+     * \return The actual capacity.
+     */
+    static std::size_t round_capacity(std::size_t capacity)
+    {
+        std::size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1u;
+        return rounded;
+    }
+
+    T *at(std::size_t index)
+    {
+        return reinterpret_cast<T *>(&m_slots[index & m_mask]);
+    }
+
+    /**
+     * \brief Move the oldest value out of the queue, that must not be empty.
+     *
+     * \param head The index of the oldest value.
+     * \return The value.
+     */
+    T take(std::size_t head)
+    {
+        T *stored = at(head);
+        T value(std::move(*stored));
+        stored->~T();
+        m_head.store(head + 1, std::memory_order_release);
+
+        // Pairs with the fence in push(): either the producer sees the room, or the consumer sees it waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_producer_waiting.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_space.notify_one();
+        }
+        return value;
+    }
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param capacity The minimum number of values the queue can hold. It is rounded up to a power of 2.
+     */
+    explicit spsc_ring(std::size_t capacity)
+            : m_capacity(round_capacity(capacity)), m_mask(m_capacity - 1), m_slots(new slot[m_capacity]),
+              m_head(0), m_tail(0), m_high_water_mark(0), m_consumer_waiting(false), m_producer_waiting(false),
+              m_interrupted(false)
+    {
+    }
+
+    spsc_ring(const spsc_ring &) = delete;
+
+    spsc_ring &operator=(const spsc_ring &) = delete;
+
+    /**
+     * \brief The class destructor.
+     *
+     * This destructor destroys the values still in the queue.
+     */
+    ~spsc_ring()
+    {
+        for (std::size_t i = m_head.load(); i != m_tail.load(); i++) at(i)->~T();
+    }
+
+    /**
+     * \brief Push a value, without waiting.
+     *
+     * This function must be called only by the producer.
+     *
+     * \param value The value to be pushed. It is moved only if the queue is not full.
+     * \return True if the value has been pushed, false if the queue is full.
+     */
+    bool try_push(T &&value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_capacity) return false;
+
+        new(at(tail)) T(std::move(value));
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        const std::size_t size = tail + 1 - m_head.load(std::memory_order_relaxed);
+        if (size > m_high_water_mark.load(std::memory_order_relaxed))
+        {
+            m_high_water_mark.store(size, std::memory_order_relaxed);
+        }
+
+        // Pairs with the fence in pop(): either the consumer sees the value, or the producer sees it waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_consumer_waiting.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ready.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * \brief Push a value, sleeping while the queue is full.
+     *
+     * This function must be called only by the producer.
+     *
+     * \param value The value to be pushed.
+     */
+    void push(T &&value)
+    {
+        if (size() == m_capacity)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_producer_waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_space.wait(lock, [this]() { return size() < m_capacity; });
+            m_producer_waiting.store(false, std::memory_order_relaxed);
+        }
+        try_push(std::move(value));
+    }
+
+    /**
+     * \brief Pop a value, without waiting.
+     *
+     * This function must be called only by the consumer.
+     *
+     * \param value A variable that will contain the value.
+     * \return True if a value has been popped, false if the queue is empty.
+     */
+    bool try_pop(T &value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+
+        value = take(head);
+        return true;
+    }
+
+    /**
+     * \brief Pop a value, sleeping until one is available or the consumer is interrupted.
+     *
+     * This function must be called only by the consumer.
+     *
+     * \param value A variable that will contain the value.
+     * \return True if a value has been popped, false if the queue is empty and the consumer has been interrupted (see
+     * interrupt()).
+     */
+    bool pop(T &value)
+    {
+        if (size() == 0)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_consumer_waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_ready.wait(lock, [this]() { return size() > 0 || m_interrupted; });
+            m_consumer_waiting.store(false, std::memory_order_relaxed);
+            if (size() == 0)
+            {
+                m_interrupted = false;
+                return false;
+            }
+        }
+        value = take(m_head.load(std::memory_order_relaxed));
+        return true;
+    }
+
+    /**
+     * \brief Wake the consumer up, even if the queue is empty.
+     *
+     * The next call to pop() finding the queue empty returns at once. This function can be called by any thread.
+     */
+    void interrupt()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interrupted = true;
+        m_ready.notify_one();
+    }
+
+    /**
+     * \brief Get the number of values in the queue.
+     *
+     * The number is exact only if called by the producer or the consumer, and may be already outdated for the other.
+     *
+     * \return The number of values.
+     */
+    std::size_t size() const
+    {
+        // The head never passes the tail read after it.
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    /**
+     * \brief Get the maximum number of values the queue can hold.
+     *
+     * \return The capacity of the queue.
+     */
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * \brief Get the maximum number of values that have been in the queue at the same time.
+     *
+     * \return The high-water mark of the queue.
+     */
+    std::size_t high_water_mark() const
+    {
+        return m_high_water_mark.load(std::memory_order_relaxed);
+    }
+};
+
+#endif //EMOTIONS_SPSC_RING_HPP
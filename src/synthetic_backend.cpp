@@ -0,0 +1,188 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file synthetic_backend.cpp
+ * \brief Implementation of synthetic_backend.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "synthetic_backend.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    /**
+     * \brief A small, portable pseudo-random generator (SplitMix64).
+     */
+    class generator
+    {
+    private:
+        std::uint64_t m_state;
+
+    public:
+        explicit generator(std::uint64_t seed) : m_state(seed)
+        {
+        }
+
+        std::uint64_t next()
+        {
+            std::uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31u);
+        }
+
+        float uniform(float min, float max)
+        {
+            return min + (max - min) * static_cast<float>(next() >> 40u) / static_cast<float>(1ull << 24u);
+        }
+
+        int below(int max)
+        {
+            return static_cast<int>(next() % static_cast<std::uint64_t>(max));
+        }
+    };
+
+    /**
+     * \brief The appearances a face can get.
+     */
+    const face_record::age_type AGES[] = {
+            face_record::age_type::unknown, face_record::age_type::under_18, face_record::age_type::from_18_to_24,
+            face_record::age_type::from_25_to_34, face_record::age_type::from_35_to_44,
+            face_record::age_type::from_45_to_54, face_record::age_type::from_55_to_64, face_record::age_type::over_64
+    };
+    const face_record::ethnicity_type ETHNICITIES[] = {
+            face_record::ethnicity_type::unknown, face_record::ethnicity_type::caucasian,
+            face_record::ethnicity_type::black_african, face_record::ethnicity_type::south_asian,
+            face_record::ethnicity_type::east_asian, face_record::ethnicity_type::hispanic
+    };
+    const face_record::gender_type GENDERS[] = {
+            face_record::gender_type::unknown, face_record::gender_type::male, face_record::gender_type::female
+    };
+
+    /**
+     * \brief Pick a value of a table.
+     */
+    template<typename T, std::size_t N>
+    T pick(generator &random, const T (&values)[N])
+    {
+        return values[random.below(static_cast<int>(N))];
+    }
+
+    /**
+     * \brief The number of pixel bytes the seed of a frame depends on.
+     */
+    const std::size_t SAMPLES = 64;
+}
+
+synthetic_backend::synthetic_backend(std::chrono::milliseconds latency, std::chrono::milliseconds jitter)
+        : m_latency(latency), m_jitter(jitter)
+{
+}
+
+std::uint64_t synthetic_backend::seed(const image_frame &frame)
+{
+    // FNV-1a over the size, the timestamp and a sample of the pixels.
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    const auto mix = [&hash](std::uint64_t value)
+    {
+        hash = (hash ^ value) * 0x100000001b3ull;
+    };
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &frame.timestamp, sizeof(bits));
+    mix(static_cast<std::uint64_t>(frame.width));
+    mix(static_cast<std::uint64_t>(frame.height));
+    mix(bits);
+
+    const std::size_t size = frame.size();
+    if (frame.pixels && size > 0)
+    {
+        for (std::size_t i = 0; i < SAMPLES; i++) mix(frame.pixels.get()[size * i / SAMPLES]);
+    }
+    return hash;
+}
+
+face_record synthetic_backend::make_face(std::uint64_t seed)
+{
+    generator random(seed);
+    face_record face;
+    face.id = 0;
+
+    for (float &emotion : face.emotions) emotion = random.uniform(0, 100);
+    // The valence spans from -100 to 100.
+    face.emotions[7] = random.uniform(-100, 100);
+    for (float &expression : face.expressions) expression = random.uniform(0, 100);
+    for (float &emoji : face.emojis) emoji = random.uniform(0, 100);
+    for (float &angle : face.orientation) angle = random.uniform(-30, 30);
+    face.interocular_distance = random.uniform(40, 120);
+
+    const auto dominant = std::max_element(face.emojis.begin(), face.emojis.end());
+    face.dominant_emoji = *dominant >= 50 ? static_cast<face_record::emoji_type>(dominant - face.emojis.begin())
+                                          : face_record::emoji_type::unknown;
+    face.glasses = random.below(2) == 1;
+    face.age = pick(random, AGES);
+    face.ethnicity = pick(random, ETHNICITIES);
+    face.gender = pick(random, GENDERS);
+    return face;
+}
+
+std::future<analysis> synthetic_backend::submit(const image_frame &frame, std::chrono::steady_clock::time_point)
+{
+    const std::uint64_t hash = seed(frame);
+    analysis result{{make_face(hash)}};
+
+    std::chrono::milliseconds delay = m_latency;
+    if (m_jitter.count() > 0)
+    {
+        generator random(~hash);
+        delay += std::chrono::milliseconds(random.below(static_cast<int>(2 * m_jitter.count() + 1))) - m_jitter;
+    }
+
+    auto promise = std::make_shared<std::promise<analysis>>();
+    std::future<analysis> future = promise->get_future();
+    if (delay.count() <= 0)
+    {
+        promise->set_value(std::move(result));
+        return future;
+    }
+
+    // Unlike the future of std::async, this one can be given up (on a timeout) without waiting for the delay.
+    std::thread([promise, delay](analysis &&found)
+                {
+                    std::this_thread::sleep_for(delay);
+                    promise->set_value(std::move(found));
+                }, std::move(result)).detach();
+    return future;
+}
+
+void synthetic_backend::recover()
+{
+}
+
+void synthetic_backend::reset()
+{
+}
@@ -0,0 +1,97 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file synthetic_backend.hpp
+ * \brief An header to fake the analysis of the images.
+ *
+ * This header contains the backend generating deterministic pseudo-random results, used to measure (and test) the
+ * tool without the Affdex SDK doing the analysis.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_SYNTHETIC_BACKEND_HPP
+#define EMOTIONS_SYNTHETIC_BACKEND_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+
+#include "emotion_backend.hpp"
+#include "face_record.hpp"
+#include "image_frame.hpp"
+
+/**
+ * \brief A backend faking the analysis.
+ *
+ * This class never loads any classifier: each frame gets a single face whose values are pseudo-random, yet within the
+ * ranges of the real ones. The values only depend on the frame (its size, timestamp and a sample of its pixels), so
+ * the same images always get the same results. The results of each frame are available after a simulated latency.
+ */
+class synthetic_backend : public emotion_backend
+{
+private:
+    const std::chrono::milliseconds m_latency;
+    const std::chrono::milliseconds m_jitter;
+
+    /**
+     * \brief Compute the seed of a frame.
+     *
+     * \param frame The frame.
+     * \return The seed of the pseudo-random values.
+     */
+    static std::uint64_t seed(const image_frame &frame);
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param latency The average time taken to analyze a frame.
+     * \param jitter The maximum difference between the time taken to analyze a frame and the average one.
+     */
+    synthetic_backend(std::chrono::milliseconds latency, std::chrono::milliseconds jitter);
+
+    /**
+     * \brief Generate a face.
+     *
+     * \param seed The seed of the pseudo-random values.
+     * \return The face.
+     */
+    static face_record make_face(std::uint64_t seed);
+
+    std::future<analysis> submit(const image_frame &frame, std::chrono::steady_clock::time_point deadline) override;
+
+    /**
+     * \brief Give up the frames past their deadline.
+     *
+     * Nothing needs to be recovered: the frames do not wait for each other, and the futures of the given up frames
+     * get their results anyway.
+     */
+    void recover() override;
+
+    /**
+     * \brief Forget the faces tracked in the previous frames.
+     *
+     * No face is ever tracked.
+     */
+    void reset() override;
+};
+
+#endif //EMOTIONS_SYNTHETIC_BACKEND_HPP
@@ -28,24 +28,139 @@
 #include <regex>
 #include <fstream>
 #include <algorithm>
+#include <cstring>
 
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
 #include "utilities.hpp"
 #include "data_uri.hpp"
+#include "base64.hpp"
+#include "manifest.hpp"
 
-exit_codes setup_options(int argc, char **argv, std::vector<std::string> &images)
+const std::string STDIN_IMAGE = "-";
+
+namespace
+{
+    const std::size_t CHUNK_SIZE = 1 << 16; ///< The size of the chunks read from a stream.
+    const std::size_t MAX_HEADER_SIZE = 1 << 10; ///< The maximum length of `data:<mediatype>;base64,`.
+
+    /**
+     * \brief Decode the rest of a data URI from a stream.
+     *
+     * \param first The part of the payload already read.
+     * \param first_size The length of `first`.
+     * \param in The stream containing the rest of the payload.
+     * \param image A buffer that will contain the decoded payload.
+     */
+    void decode_data_uri(const char *first, std::size_t first_size, std::istream &in, std::vector<unsigned char> &image)
+    {
+        std::vector<char> chunk(first, first + first_size);
+        chunk.resize(std::max(first_size, CHUNK_SIZE));
+
+        base64::decoder decoder;
+        std::size_t size = 0;
+        std::size_t read = first_size;
+        image.clear();
+        do
+        {
+            image.resize(size + base64::decoder::max_decoded_size(read));
+            size += decoder.update(chunk.data(), read, image.data() + size);
+        } while (!decoder.ended() && (read = in.read(chunk.data(), CHUNK_SIZE).gcount()) > 0);
+        image.resize(size + 2);
+        size += decoder.finish(image.data() + size);
+        image.resize(size);
+    }
+}
+
+void read_image(std::istream &in, std::vector<unsigned char> &image)
+{
+    // The first chunk is read straight into the image: it is either the start
+    // of a raw image or the header of a data URI.
+    std::size_t size = 0;
+    do
+    {
+        image.resize(size + CHUNK_SIZE);
+        size += in.read(reinterpret_cast<char *>(image.data()) + size, CHUNK_SIZE).gcount();
+    } while (in && size < MAX_HEADER_SIZE);
+
+    const char *start = reinterpret_cast<const char *>(image.data());
+    const char *comma = static_cast<const char *>(std::memchr(start, ',', std::min(size, MAX_HEADER_SIZE)));
+    if (comma != nullptr && data_uri_view::is_data_uri(start, comma - start + 1))
+    {
+        decode_data_uri(comma + 1, start + size - comma - 1, in, image);
+        return;
+    }
+
+    while (in.peek() != std::istream::traits_type::eof())
+    {
+        image.resize(std::max(size + CHUNK_SIZE, image.capacity()));
+        size += in.read(reinterpret_cast<char *>(image.data()) + size, image.size() - size).gcount();
+    }
+    image.resize(size);
+}
+
+void decode_data_uri(const data_uri_view &uri, std::vector<unsigned char> &image)
+{
+    image.resize(base64::decoded_size(uri.get_data(), uri.get_data_size()));
+    image.resize(base64::decode(uri.get_data(), uri.get_data_size(), image.data()));
+}
+
+exit_codes setup_options(int argc, char **argv, settings &config)
 {
     namespace po = boost::program_options;
 
-    std::string file_path;
+    std::vector<std::string> image_args;
+    bool read_stdin = false;
+    bool read_sessions = false;
+    std::string classifiers;
+    double timeout = config.timeout.count() / 1000.0;
+#ifdef EMOTIONS_WITH_AFFDEX
+    std::string backend = "affdex";
+#else
+    std::string backend = "synthetic";
+#endif
+    long long synthetic_latency = 0;
+    long long synthetic_jitter = 0;
 
     po::options_description options("Available options");
-    options.add_options()("help,h", "Display this help message")("file,f", po::value<std::string>(&file_path),
-                                                                 "The file containing the images to be analyzed (as a data URI)");
+    options.add_options()("help,h", "Display this help message")("file,f", po::value<std::string>(&config.file),
+                                                                 "The file containing the images to be analyzed (as a data URI)")
+            ("stdin", po::bool_switch(&read_stdin),
+             "Read the images (as data URIs, one per line) from the standard input, writing each result as soon as it is available")
+            ("session", po::bool_switch(&read_sessions),
+             "Read the frames of sessions (as SESSION<tab>TIMESTAMP<tab>DATA_URI, one per line) from the standard input, tracking the faces within each session")
+            ("stream", po::bool_switch(&config.stream_results),
+             "Write each result (as a line) as soon as it is available, instead of an array of all of them at the end")
+            ("flush-every", po::value<std::size_t>(&config.flush_every)->default_value(config.flush_every),
+             "The number of results written between two flushes of the output (0 to flush it only when its buffer is full)")
+            ("serve", po::value<std::string>(&config.serve_path),
+             "Keep analyzing the images sent by the clients of the given Unix domain socket")
+            ("max-pixels", po::value<std::size_t>(&config.limits.max_pixels),
+             "Downscale the images having more than the given number of pixels")
+            ("max-dimension", po::value<int>(&config.limits.max_dimension),
+             "Downscale the images whose width or height exceed the given value")
+            ("decode-threads", po::value<std::size_t>(&config.decode_threads)->default_value(config.decode_threads),
+             "The number of threads decoding the images ahead of the analysis (0 to decode them one at a time)")
+            ("prefetch", po::value<std::size_t>(&config.prefetch)->default_value(config.prefetch),
+             "The maximum number of images decoded ahead of the analysis")
+            ("classifiers", po::value<std::string>(&classifiers),
+             "The classifiers to be run, among emotions, expressions, emojis and appearances, separated by commas (default: all of them)")
+            ("timeout", po::value<double>(&timeout)->default_value(timeout),
+             "The maximum time, in seconds, to analyze an image (0 to wait as long as needed)")
+            ("workers", po::value<std::size_t>(&config.workers)->default_value(config.workers),
+             "The number of detectors analyzing the images at the same time")
+            ("shards", po::value<std::size_t>(&config.shards)->default_value(config.shards),
+             "The number of processes the file given through --file is split among")
+            ("backend", po::value<std::string>(&backend)->default_value(backend),
+             "The backend analyzing the images: affdex, or synthetic to generate deterministic results without the SDK (the only one if the tool has been built without it)")
+            ("synthetic-latency", po::value<long long>(&synthetic_latency)->default_value(synthetic_latency),
+             "The average time, in milliseconds, the synthetic backend takes to analyze an image")
+            ("synthetic-jitter", po::value<long long>(&synthetic_jitter)->default_value(synthetic_jitter),
+             "The maximum variation, in milliseconds, of the time the synthetic backend takes to analyze an image");
 
     po::options_description hidden("Hidden options");
-    hidden.add_options()("image", po::value<std::vector<std::string>>(&images)->multitoken(),
+    hidden.add_options()("image", po::value<std::vector<std::string>>(&image_args)->multitoken(),
                          "The image to be analyzed (as a data URI)");
 
     po::positional_options_description arguments;
@@ -65,54 +180,118 @@ exit_codes setup_options(int argc, char **argv, std::vector<std::string> &images
         {
             std::cout << "Usage: " << argv[0] << " [options] DATA_URI..." << std::endl;
             std::cout << "  or:  " << argv[0] << " [options] --file FILE" << std::endl;
+            std::cout << "  or:  " << argv[0] << " [options] --stdin" << std::endl;
+            std::cout << "  or:  " << argv[0] << " [options] --serve SOCKET" << std::endl;
+            std::cout << "  or:  " << argv[0] << " [options] --session" << std::endl;
             std::cout << "Analyze the emotions of an image using Affectiva." << std::endl;
             std::cout << std::endl
                       << options << std::endl;
             return exit_codes::HALT;
         }
-        else if (args.count("image") && args.count("file"))
+        else if (args.count("image") + args.count("file") + read_stdin + read_sessions + args.count("serve") > 1)
         {
-            throw po::error("You cannot specify both a file and an image");
+            throw po::error("You can specify only one of: images, a file, the standard input, sessions or a socket");
         }
-        else if (!args.count("image") && !args.count("file"))
+        else if (!args.count("image") && !args.count("file") && !read_stdin && !read_sessions && !args.count("serve"))
         {
             throw po::error("You must specify at least an image!");
         }
 
-        if (args.count("file"))
+        if (args.count("classifiers"))
         {
-            std::ifstream file(file_path, std::ios::in | std::ios::binary);
-            std::flush(std::cerr);
-            std::string line;
-            images.clear();
-            while (std::getline(file, line))
+            try
+            {
+                config.classifiers = classifier_set::parse(classifiers);
+            }
+            catch (std::invalid_argument &e)
             {
-                images.push_back(data_uri(line).get_data());
+                throw po::error(e.what());
+            }
+        }
+
+        if (!(timeout >= 0)) throw po::error("The timeout cannot be negative");
+        config.timeout = std::chrono::milliseconds(static_cast<long long>(timeout * 1000));
+
+        if (backend == "synthetic") config.synthetic = true;
+        else if (backend != "affdex") throw po::error("Unknown backend '" + backend + "'");
+#ifndef EMOTIONS_WITH_AFFDEX
+        else throw po::error("The tool has been built without the Affdex SDK: only the synthetic backend exists");
+#endif
+        if (synthetic_latency < 0 || synthetic_jitter < 0)
+        {
+            throw po::error("The latency of the synthetic backend cannot be negative");
+        }
+        config.synthetic_latency = std::chrono::milliseconds(synthetic_latency);
+        config.synthetic_jitter = std::chrono::milliseconds(synthetic_jitter);
+
+        if (config.workers == 0) throw po::error("There must be at least a worker");
+        if (config.shards == 0) throw po::error("There must be at least a shard");
+        if (config.shards > 1 && !args.count("file"))
+        {
+            throw po::error("Only a file given through --file can be split in shards");
+        }
+        if (config.shards > 1 && (config.stream_results || !args["flush-every"].defaulted()))
+        {
+            // The results of the shards are only merged once every shard is done.
+            throw po::error("The results of the shards cannot be streamed");
+        }
+
+        if (args.count("serve"))
+        {
+            if (config.serve_path.empty()) throw po::error("The socket path cannot be empty");
+        }
+        else if (read_sessions)
+        {
+            config.sessions = true;
+            config.stream_results = true;
+        }
+        else if (read_stdin)
+        {
+            config.images = std::make_unique<data_uri_stream_source>(std::cin);
+            config.stream_results = true;
+        }
+        else if (args.count("file"))
+        {
+            try
+            {
+                config.images = std::make_unique<manifest>(config.file);
+            }
+            catch (std::exception &)
+            {
+                throw po::error("Unable to read the file '" + config.file + "'");
             }
         }
         else
         {
-            for (auto &image : images)
+            auto chain = std::make_unique<source_chain>();
+            for (auto &image : image_args)
             {
-                if (data_uri::is_data_uri(image))
+                // Files are only checked here: they are read (and decoded)
+                // right before the image is analyzed.
+                if (data_uri_view::is_data_uri(image.data(), image.size()))
                 {
-                    image = data_uri(image).get_data();
+                    chain->append(std::make_unique<data_uri_source>(std::move(image)));
                 }
-                else
+                else if (image == STDIN_IMAGE || boost::filesystem::is_regular_file(image))
                 {
-                    std::ifstream file(image, std::ios::in | std::ios::binary);
-                    image = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
-
-                    if (data_uri::is_data_uri(image))
-                    {
-                        image = data_uri(image).get_data();
-                    }
-                    else
+                    chain->append(std::make_unique<file_source>(std::move(image)));
+                }
+                else if (boost::filesystem::is_directory(image))
+                {
+                    std::vector<std::string> files;
+                    for (const auto &entry : boost::filesystem::directory_iterator(image))
                     {
-                        throw po::error("A given image is invalid!");
+                        if (boost::filesystem::is_regular_file(entry.status())) files.push_back(entry.path().string());
                     }
+                    std::sort(files.begin(), files.end());
+                    for (auto &file : files) chain->append(std::make_unique<file_source>(std::move(file)));
+                }
+                else
+                {
+                    throw po::error("A given image is invalid!");
                 }
             }
+            config.images = std::move(chain);
         }
     }
     catch (po::error &e)
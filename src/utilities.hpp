@@ -29,7 +29,47 @@
 #ifndef EMOTIONS_UTILITIES_HPP
 #define EMOTIONS_UTILITIES_HPP
 
+#include <chrono>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "exit_codes.hpp"
+#include "data_uri.hpp"
+#include "image_source.hpp"
+#include "image_decoder.hpp"
+#include "classifiers.hpp"
+
+/**
+ * \brief The image argument reading a data URI from the standard input.
+ */
+extern const std::string STDIN_IMAGE;
+
+/**
+ * \brief The settings of the tool.
+ *
+ * This structure contains the settings given through the CLI API.
+ */
+struct settings
+{
+    std::unique_ptr<image_source> images; ///< The source of the images to be analyzed.
+    bool sessions = false; ///< Whether the standard input contains the frames of sessions.
+    std::chrono::milliseconds timeout{30000}; ///< The maximum time to analyze an image (0 to wait as long as needed).
+    classifier_set classifiers; ///< The classifiers to be enabled.
+    bool synthetic = false; ///< Whether the results are generated by the synthetic backend instead of the detectors.
+    std::chrono::milliseconds synthetic_latency{0}; ///< The average time the synthetic backend takes for an image.
+    std::chrono::milliseconds synthetic_jitter{0}; ///< The maximum variation of the time taken by the synthetic backend.
+    std::string serve_path; ///< The socket to serve the analysis on, if any.
+    bool stream_results = false; ///< Whether each result is written (as a line) as soon as it is available.
+    std::size_t flush_every = 1; ///< The number of streamed results between flushes (0 when the buffer is full).
+    decode_limits limits; ///< The limits on the size of the decoded images.
+    std::size_t decode_threads = 2; ///< The number of threads decoding the images ahead of the detector.
+    std::size_t prefetch = 4; ///< The maximum number of images decoded ahead of the detector.
+    std::size_t workers = 1; ///< The number of detectors analyzing the images at the same time.
+    std::string file; ///< The file given through `--file`, if any.
+    std::size_t shards = 1; ///< The number of processes the file is split among.
+};
 
 /**
  * @brief Set up the tool's options and arguments.
@@ -38,13 +78,33 @@
  *
  * @param argc The length of `argv`.
  * @param argv The array of arguments passed via CLI.
- * @param images A variable that will contain the images passed through the CLI API.
+ * @param config A variable that will contain the settings passed through the CLI API.
  * @return An \ref exit_codes "exit code":
  *   - exit_codes::OK If the given arguments are valid and no errors occurred.
  *   - exit_codes::HALT If the given arguments are valid but the argument combination stops the execution.
  *   - exit_codes::ARGUMENT_ERROR If the given arguments are invalid
  *   - exit_codes::UNKNOWN_ARGUMENT_ERROR If an unknown error occurred.
  */
-exit_codes setup_options(int argc, char **argv, std::vector<std::string> &images);
+exit_codes setup_options(int argc, char **argv, settings &config);
+
+/**
+ * @brief Read an image from a stream.
+ *
+ * This function reads an image from a stream in fixed-size chunks. If the stream contains a data URI, its base64
+ * payload is decoded while it is being read; otherwise the stream is taken as the raw bytes of the image (e.g. a JPEG
+ * or PNG file), which are read straight into `image`.
+ *
+ * @param in The stream containing the image.
+ * @param image A buffer that will contain the image.
+ */
+void read_image(std::istream &in, std::vector<unsigned char> &image);
+
+/**
+ * @brief Decode the payload of a data URI.
+ *
+ * @param uri The data URI.
+ * @param image A buffer that will contain the decoded payload.
+ */
+void decode_data_uri(const data_uri_view &uri, std::vector<unsigned char> &image);
 
 #endif //EMOTIONS_UTILITIES_HPP
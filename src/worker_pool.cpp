@@ -0,0 +1,106 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file worker_pool.cpp
+ * \brief Implementation of worker_pool.hpp
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#include "worker_pool.hpp"
+
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+worker_pool::worker_pool(std::vector<emotion_backend *> backends, std::chrono::milliseconds timeout)
+        : m_backends(std::move(backends)), m_timeout(timeout), m_next(0)
+{
+}
+
+void worker_pool::run(decode_pipeline &images, frame_pool &pool, const result_handler &handler)
+{
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < m_backends.size(); i++)
+    {
+        threads.emplace_back([this, i, &images, &pool, &handler]()
+                             {
+                                 work(*m_backends[i], images, pool, handler);
+                             });
+    }
+    if (!m_backends.empty()) work(*m_backends.front(), images, pool, handler);
+    for (auto &thread : threads) thread.join();
+}
+
+void worker_pool::work(emotion_backend &worker, decode_pipeline &images, frame_pool &pool, const result_handler &handler)
+{
+    decoded_image image;
+    while (images.next(image))
+    {
+        outcome done{false, {}, {}};
+        if (!image.frame)
+        {
+            std::cerr << "ERROR: " << image.error << std::endl;
+            done.error = image.error;
+        }
+        else
+        {
+            bool reading = false;
+            try
+            {
+                done.result = worker.analyze(*image.frame, m_timeout);
+                done.analyzed = true;
+            }
+            catch (emotion_backend::timed_out &e)
+            {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+                done.error = e.what();
+                reading = true;
+            }
+            catch (std::exception &e)
+            {
+                // e.g. an affdex::AffdexException or std::bad_alloc: the image still gets its outcome, or the other
+                // workers would wait for it forever.
+                std::cerr << "Encountered an exception while processing: " << e.what() << std::endl;
+                done.error = e.what();
+            }
+
+            // The detector is done with the pixels, unless it may still be reading them: the frame then keeps them,
+            // out of the pool.
+            if (!reading) pool.release(image.pixels);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (image.index != m_next)
+        {
+            m_early.emplace(image.index, std::move(done));
+            continue;
+        }
+
+        // Hand over this result and the ones it was holding back.
+        handler(done.analyzed ? &done.result : nullptr, done.error);
+        m_next++;
+        for (auto it = m_early.begin(); it != m_early.end() && it->first == m_next; it = m_early.erase(it), m_next++)
+        {
+            handler(it->second.analyzed ? &it->second.result : nullptr, it->second.error);
+        }
+    }
+}
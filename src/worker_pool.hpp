@@ -0,0 +1,110 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file worker_pool.hpp
+ * \brief An header to analyze the images on several detectors.
+ *
+ * This header contains the pool of workers sharing the images among many detectors.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#ifndef EMOTIONS_WORKER_POOL_HPP
+#define EMOTIONS_WORKER_POOL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "emotion_backend.hpp"
+#include "decode_pipeline.hpp"
+#include "frame_pool.hpp"
+
+/**
+ * \brief A pool of workers, each analyzing the images on its own detector.
+ *
+ * Each worker takes the next image from the shared pipeline as soon as its detector is free, so a slow image does
+ * not hold the others back. The results are handed over in the order of the images anyway: the results coming
+ * early wait in a reorder buffer.
+ */
+class worker_pool
+{
+public:
+    /**
+     * \brief The function receiving the results.
+     *
+     * The function is called once per image, in the order of the images and never concurrently. Its first argument
+     * is null if the image could not be analyzed, and the second one then tells why.
+     */
+    using result_handler = std::function<void(const analysis *, const std::string &)>;
+
+private:
+    struct outcome
+    {
+        bool analyzed;
+        analysis result;
+        std::string error;
+    };
+
+    const std::vector<emotion_backend *> m_backends;
+    const std::chrono::milliseconds m_timeout;
+
+    std::mutex m_mutex;
+    std::map<std::size_t, outcome> m_early;
+    std::size_t m_next;
+
+    /**
+     * \brief Analyze the images on a detector, until there are no more images.
+     *
+     * \param worker The backend of the worker.
+     * \param images The images.
+     * \param pool The pool the pixels are returned to.
+     * \param handler The function receiving the results.
+     */
+    void work(emotion_backend &worker, decode_pipeline &images, frame_pool &pool, const result_handler &handler);
+
+public:
+    /**
+     * \brief The class constructor.
+     *
+     * \param backends The backends analyzing the images, one per worker.
+     * \param timeout The maximum time to analyze an image, or 0 to wait as long as needed. An image taking longer is
+     * not analyzed, and its detector is restarted.
+     */
+    worker_pool(std::vector<emotion_backend *> backends, std::chrono::milliseconds timeout);
+
+    /**
+     * \brief Analyze all the images.
+     *
+     * This function runs a worker on the calling thread and each other one on its own thread, returning when every
+     * image has been analyzed.
+     *
+     * \param images The images.
+     * \param pool The pool the pixels are returned to.
+     * \param handler The function receiving the results.
+     */
+    void run(decode_pipeline &images, frame_pool &pool, const result_handler &handler);
+};
+
+#endif //EMOTIONS_WORKER_POOL_HPP
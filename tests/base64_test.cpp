@@ -0,0 +1,331 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * \file base64_test.cpp
+ * \brief The tests of the base64 decoders.
+ *
+ * This file checks every block decoder supported by the CPU, byte for byte, against the decoding loop the tool used
+ * before the block decoders were introduced, and the incremental decoder against the one-shot one, for every way of
+ * splitting the input.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#define BOOST_TEST_MODULE base64
+#include <boost/test/included/unit_test.hpp>
+
+#include "base64.hpp"
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const base64::kernel KERNELS[] = {base64::kernel::scalar, base64::kernel::sse41, base64::kernel::avx2};
+
+    /**
+     * \brief Select a kernel for the lifetime of the object, restoring the previous one afterwards.
+     */
+    class kernel_guard
+    {
+    private:
+        base64::kernel m_previous;
+        bool m_supported;
+
+    public:
+        explicit kernel_guard(base64::kernel k)
+                : m_previous(base64::active_kernel()), m_supported(base64::use_kernel(k))
+        {
+        }
+
+        ~kernel_guard()
+        {
+            base64::use_kernel(m_previous);
+        }
+
+        bool supported() const
+        {
+            return m_supported;
+        }
+    };
+
+    /**
+     * \brief Get the kernels supported by the CPU.
+     */
+    std::vector<base64::kernel> supported_kernels()
+    {
+        std::vector<base64::kernel> kernels;
+        for (base64::kernel k : KERNELS)
+        {
+            if (kernel_guard(k).supported()) kernels.push_back(k);
+            else BOOST_TEST_MESSAGE("Kernel " << static_cast<int>(k) << " not supported by the CPU, skipped");
+        }
+        return kernels;
+    }
+
+    /**
+     * \brief The original decoder (René Nyffenegger's loop), the reference of the tests.
+     *
+     * It stops at the first byte that is not a base64 symbol, whitespace included: the current decoders skip
+     * whitespace, so they are compared with it on the input with the whitespace removed.
+     */
+    std::string reference_decode(std::string const &encoded_string)
+    {
+        const std::string base64_chars =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "abcdefghijklmnopqrstuvwxyz"
+                "0123456789+/";
+        auto is_base64 = [](unsigned char c) { return (isalnum(c) || (c == '+') || (c == '/')); };
+
+        int in_len = encoded_string.size();
+        int i = 0;
+        int j = 0;
+        int in_ = 0;
+        unsigned char char_array_4[4], char_array_3[3];
+        std::string ret = "";
+
+        while (in_len-- && ( encoded_string[in_] != '=') && is_base64(encoded_string[in_])) {
+            char_array_4[i++] = encoded_string[in_]; in_++;
+            if (i ==4) {
+                for (i = 0; i <4; i++)
+                    char_array_4[i] = base64_chars.find(char_array_4[i]);
+
+                char_array_3[0] = ( char_array_4[0] << 2       ) + ((char_array_4[1] & 0x30) >> 4);
+                char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
+                char_array_3[2] = ((char_array_4[2] & 0x3) << 6) +   char_array_4[3];
+
+                for (i = 0; (i < 3); i++)
+                    ret += char_array_3[i];
+                i = 0;
+            }
+        }
+
+        if (i) {
+            for (j = 0; j < i; j++)
+                char_array_4[j] = base64_chars.find(char_array_4[j]);
+
+            char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
+            char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
+
+            for (j = 0; (j < i - 1); j++) ret += char_array_3[j];
+        }
+
+        return ret;
+    }
+
+    /**
+     * \brief Decode a buffer with the original decoder, skipping whitespace.
+     */
+    std::string reference(const std::string &s)
+    {
+        std::string stripped;
+        for (char c : s)
+        {
+            if (!std::isspace(static_cast<unsigned char>(c))) stripped += c;
+        }
+        return reference_decode(stripped);
+    }
+
+    /**
+     * \brief Decode a buffer with both interfaces, checking that they agree and that decoded_size() is an upper bound.
+     */
+    std::string decode(const std::string &s)
+    {
+        std::vector<unsigned char> out(base64::decoded_size(s.data(), s.size()) + 1, 0xaa);
+        const std::size_t written = base64::decode(s.data(), s.size(), out.data());
+        BOOST_TEST_REQUIRE(written <= out.size() - 1);
+        BOOST_TEST(out.back() == 0xaa);
+
+        const std::string decoded(out.begin(), out.begin() + written);
+        BOOST_TEST(base64::decode(s) == decoded);
+        return decoded;
+    }
+
+    std::string random_bytes(std::mt19937 &random, std::size_t len)
+    {
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::string s(len, '\0');
+        for (char &c : s) c = static_cast<char>(byte(random));
+        return s;
+    }
+
+    /**
+     * \brief Build the inputs: encoded random data, with whitespace, truncations and invalid bytes at random positions.
+     */
+    std::vector<std::string> inputs()
+    {
+        const std::string SPACES = " \t\n\v\f\r";
+        const std::string INVALID = "=-_.*\x80\xff";
+
+        std::mt19937 random(42);
+        std::vector<std::string> result;
+        for (std::size_t len = 0; len <= 300; len++)
+        {
+            const std::string encoded = base64::encode(reinterpret_cast<const unsigned char *>(
+                                                               random_bytes(random, len).data()),
+                                                       static_cast<unsigned int>(len));
+            result.push_back(encoded);
+            result.push_back(encoded + "\r\n");
+            if (encoded.empty()) continue;
+
+            std::uniform_int_distribution<std::size_t> position(0, encoded.size() - 1);
+
+            std::string spaced = encoded;
+            for (int i = 0; i < 4; i++)
+            {
+                spaced.insert(position(random), 1, SPACES[random() % SPACES.size()]);
+            }
+            result.push_back(spaced);
+
+            std::string lines = encoded;
+            for (std::size_t i = 76; i < lines.size(); i += 78) lines.insert(i, "\r\n");
+            result.push_back(lines);
+
+            result.push_back(encoded.substr(0, position(random)));
+
+            std::string invalid = encoded;
+            invalid[position(random)] = INVALID[random() % INVALID.size()];
+            result.push_back(invalid);
+
+            result.push_back(encoded + "QUJD");
+        }
+
+        // Random bytes, mostly outside the alphabet, stop every decoder early.
+        for (std::size_t len = 0; len <= 64; len++) result.push_back(random_bytes(random, len));
+        return result;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+    std::mt19937 random(7);
+    for (std::size_t len = 0; len <= 300; len++)
+    {
+        const std::string data = random_bytes(random, len);
+        const std::string encoded = base64::encode(reinterpret_cast<const unsigned char *>(data.data()),
+                                                   static_cast<unsigned int>(len));
+        BOOST_TEST(decode(encoded) == data);
+        BOOST_TEST(base64::decoded_size(encoded.data(), encoded.size()) == len);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(padding_and_invalid_bytes)
+{
+    const std::string CASES[] = {"", "QQ==", "QUI=", "QUJD", "QQ", "QUI", "Q", " Q U\r\nJ\tD ", "QQ==QUJD",
+                                 "QUJD-QUJD", "QU\x80JD"};
+
+    for (base64::kernel k : supported_kernels())
+    {
+        kernel_guard guard(k);
+        for (const std::string &s : CASES)
+        {
+            BOOST_TEST_CONTEXT("kernel " << static_cast<int>(k) << ", input \"" << s << "\"")
+            {
+                BOOST_TEST(decode(s) == reference(s));
+            }
+        }
+    }
+    BOOST_TEST(reference("QUI=") == "AB");
+    BOOST_TEST(reference(" Q U\r\nJ\tD ") == "ABC");
+}
+
+BOOST_AUTO_TEST_CASE(kernels_match_the_original_decoder)
+{
+    const std::vector<std::string> cases = inputs();
+    std::vector<std::string> expected;
+    for (const std::string &s : cases) expected.push_back(reference(s));
+
+    for (base64::kernel k : supported_kernels())
+    {
+        kernel_guard guard(k);
+        for (std::size_t i = 0; i < cases.size(); i++)
+        {
+            BOOST_TEST_CONTEXT("kernel " << static_cast<int>(k) << ", input " << i)
+            {
+                BOOST_TEST(decode(cases[i]) == expected[i]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incremental_decoder_matches_decode)
+{
+    const std::vector<std::string> cases = inputs();
+    for (base64::kernel k : supported_kernels())
+    {
+        kernel_guard guard(k);
+        for (std::size_t i = 0; i < cases.size(); i += 5)
+        {
+            const std::string &s = cases[i];
+            const std::string expected = base64::decode(s);
+
+            // Chunks of every size from 1 to 7 bytes end in every position of a quad.
+            for (std::size_t chunk = 1; chunk <= 7; chunk++)
+            {
+                BOOST_TEST_CONTEXT("kernel " << static_cast<int>(k) << ", input " << i << ", chunk " << chunk)
+                {
+                    base64::decoder d;
+                    std::string decoded;
+                    std::vector<unsigned char> out(base64::decoder::max_decoded_size(chunk));
+                    for (std::size_t start = 0; start < s.size(); start += chunk)
+                    {
+                        const std::size_t len = std::min(chunk, s.size() - start);
+                        const std::size_t written = d.update(s.data() + start, len, out.data());
+                        BOOST_TEST_REQUIRE(written <= out.size());
+                        decoded.append(out.begin(), out.begin() + written);
+                    }
+                    const std::size_t written = d.finish(out.data());
+                    decoded.append(out.begin(), out.begin() + written);
+
+                    BOOST_TEST(d.ended());
+                    BOOST_TEST(decoded == expected);
+                }
+            }
+
+            // A single split point, anywhere in the input.
+            for (std::size_t split = 0; split <= s.size(); split++)
+            {
+                BOOST_TEST_CONTEXT("kernel " << static_cast<int>(k) << ", input " << i << ", split " << split)
+                {
+                    base64::decoder d;
+                    std::vector<unsigned char> out(base64::decoder::max_decoded_size(s.size()) + 2);
+                    std::size_t written = d.update(s.data(), split, out.data());
+                    written += d.update(s.data() + split, s.size() - split, out.data() + written);
+                    written += d.finish(out.data() + written);
+                    BOOST_TEST(std::string(out.begin(), out.begin() + written) == expected);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incremental_decoder_ignores_data_after_the_end)
+{
+    base64::decoder d;
+    unsigned char out[6];
+    BOOST_TEST(d.update("QQ", 2, out) == 0u);
+    BOOST_TEST(!d.ended());
+    BOOST_TEST(d.update("=", 1, out) == 0u);
+    BOOST_TEST(d.ended());
+    BOOST_TEST(d.update("QUJD", 4, out) == 0u);
+    BOOST_TEST(d.finish(out) == 1u);
+    BOOST_TEST(out[0] == 'A');
+}
@@ -0,0 +1,186 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * \file shards_test.cpp
+ * \brief The tests of the split of a file in shards and of the merge of their results.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#define BOOST_TEST_MODULE shards
+#include <boost/test/included/unit_test.hpp>
+
+#include "manifest.hpp"
+#include "shards.hpp"
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+namespace
+{
+    /**
+     * \brief A temporary file, removed when the test is done.
+     */
+    class temporary_file
+    {
+    private:
+        std::string m_path;
+
+    public:
+        explicit temporary_file(const std::string &content)
+                : m_path((boost::filesystem::temp_directory_path() /
+                          boost::filesystem::unique_path("emotions-test-%%%%-%%%%-%%%%")).string())
+        {
+            std::ofstream file(m_path, std::ios::out | std::ios::binary);
+            file << content;
+        }
+
+        temporary_file(const temporary_file &) = delete;
+
+        temporary_file &operator=(const temporary_file &) = delete;
+
+        ~temporary_file()
+        {
+            boost::system::error_code ignored;
+            boost::filesystem::remove(m_path, ignored);
+        }
+
+        const std::string &path() const
+        {
+            return m_path;
+        }
+    };
+
+    /**
+     * \brief Split a text in its non-empty lines, without their line endings.
+     */
+    std::vector<std::string> lines_of(const std::string &text)
+    {
+        std::vector<std::string> lines;
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) lines.push_back(line);
+        }
+        return lines;
+    }
+
+    /**
+     * \brief Read all the images of a source.
+     */
+    std::vector<std::string> read_all(image_source &source)
+    {
+        std::vector<std::string> lines;
+        raw_image image;
+        while (source.read(image)) lines.emplace_back(image.uri, image.uri_size);
+        return lines;
+    }
+
+    /**
+     * \brief The files exercising the boundaries of the lines.
+     */
+    std::vector<std::string> manifests()
+    {
+        return {
+                "",
+                "\n",
+                "data:a\n",
+                "data:a\ndata:bb\ndata:ccc\n",
+                "data:a\r\ndata:bb\r\n\r\ndata:ccc\r\n",
+                "\n\ndata:a\n\n\ndata:bb\n\n",
+                "data:a\ndata:bb\ndata:last",
+                "data:a\r\ndata:bb\r\ndata:last\r",
+                "data:" + std::string(100, 'x') + "\ndata:y\ndata:" + std::string(37, 'z') + "\n"
+        };
+    }
+
+    /**
+     * \brief Merge the results written by the shards.
+     */
+    std::string merge(const std::vector<std::string> &shards)
+    {
+        std::deque<temporary_file> files;
+        std::vector<std::string> paths;
+        for (const auto &results : shards)
+        {
+            files.emplace_back(results);
+            paths.push_back(files.back().path());
+        }
+
+        std::ostringstream out;
+        merge_results(paths, out);
+        return out.str();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(manifest_reads_every_line)
+{
+    for (const auto &content : manifests())
+    {
+        const temporary_file file(content);
+        manifest whole(file.path());
+        BOOST_TEST(read_all(whole) == lines_of(content));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(every_line_belongs_to_exactly_one_shard)
+{
+    for (const auto &content : manifests())
+    {
+        const temporary_file file(content);
+        const std::vector<std::string> expected = lines_of(content);
+
+        // More shards than bytes leave some of them empty.
+        for (std::size_t shards = 1; shards <= content.size() + 2; shards++)
+        {
+            std::vector<std::string> lines;
+            for (std::size_t shard = 0; shard < shards; shard++)
+            {
+                manifest part(file.path(), shard, shards);
+                const std::vector<std::string> found = read_all(part);
+                lines.insert(lines.end(), found.begin(), found.end());
+            }
+            BOOST_TEST(lines == expected, "with " << shards << " shards of '" << content << "'");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merged_results_match_a_single_process)
+{
+    const std::vector<std::string> results = {
+            R"([{"faceId":0,"dominantEmoji":"smiley"}])",
+            "[]",
+            R"({"error":"Unable to decode an image"})",
+            R"([{"faceId":0,"dominantEmoji":"wink"},{"faceId":1,"dominantEmoji":"laughing"}])"
+    };
+    // A single process writes the results as a JSON array.
+    const std::string single = "[" + results[0] + "," + results[1] + "," + results[2] + "," + results[3] + "]\n";
+
+    BOOST_TEST(merge({results[0] + "\n" + results[1] + "\n" + results[2] + "\n" + results[3] + "\n"}) == single);
+    BOOST_TEST(merge({results[0] + "\n", results[1] + "\n" + results[2] + "\n", results[3] + "\n"}) == single);
+    // Some shards may have no images, and the last result may not end with a newline.
+    BOOST_TEST(merge({"", results[0] + "\n" + results[1] + "\n", "", results[2] + "\n\n" + results[3]}) == single);
+    BOOST_TEST(merge({"", ""}) == "[]\n");
+}
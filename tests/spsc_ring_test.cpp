@@ -0,0 +1,152 @@
+/*
+ * The tool for the emotion analysis created for Andrea Esposito's Bachelor's Thesis.
+ * Copyright (C) 2020 Andrea Esposito <a.esposito39@studenti.uniba.it>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ * \file spsc_ring_test.cpp
+ * \brief The tests of the lock-free queue between two threads.
+ *
+ * \author Andrea Esposito
+ * \date October 18, 2026
+ */
+
+#define BOOST_TEST_MODULE spsc_ring
+#include <boost/test/included/unit_test.hpp>
+
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+BOOST_AUTO_TEST_CASE(capacity_is_rounded_to_a_power_of_2)
+{
+    BOOST_TEST(spsc_ring<int>(1).capacity() == 1u);
+    BOOST_TEST(spsc_ring<int>(5).capacity() == 8u);
+    BOOST_TEST(spsc_ring<int>(64).capacity() == 64u);
+}
+
+BOOST_AUTO_TEST_CASE(values_are_popped_in_order)
+{
+    spsc_ring<int> ring(4);
+    int value;
+    BOOST_TEST(!ring.try_pop(value));
+
+    // Wrap around the slots a few times.
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < 4; i++) BOOST_TEST(ring.try_push(round * 4 + i));
+        BOOST_TEST(!ring.try_push(-1));
+        BOOST_TEST(ring.size() == 4u);
+
+        for (int i = 0; i < 4; i++)
+        {
+            BOOST_TEST_REQUIRE(ring.try_pop(value));
+            BOOST_TEST(value == round * 4 + i);
+        }
+        BOOST_TEST(!ring.try_pop(value));
+    }
+    BOOST_TEST(ring.high_water_mark() == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(refused_values_are_not_moved)
+{
+    spsc_ring<std::unique_ptr<int>> ring(1);
+    BOOST_TEST(ring.try_push(std::unique_ptr<int>(new int(1))));
+
+    std::unique_ptr<int> refused(new int(2));
+    BOOST_TEST(!ring.try_push(std::move(refused)));
+    BOOST_TEST_REQUIRE(bool(refused));
+    BOOST_TEST(*refused == 2);
+}
+
+BOOST_AUTO_TEST_CASE(remaining_values_are_destroyed)
+{
+    std::shared_ptr<int> counted = std::make_shared<int>(0);
+    {
+        spsc_ring<std::shared_ptr<int>> ring(4);
+        for (int i = 0; i < 3; i++) ring.try_push(std::shared_ptr<int>(counted));
+
+        std::shared_ptr<int> value;
+        ring.try_pop(value);
+        BOOST_TEST(counted.use_count() == 4);
+    }
+    BOOST_TEST(counted.use_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(push_waits_for_room)
+{
+    spsc_ring<int> ring(1);
+    ring.push(1);
+
+    std::atomic<bool> pushed(false);
+    std::thread producer([&]() {
+        ring.push(2);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_TEST(!pushed);
+
+    int value;
+    BOOST_TEST(ring.pop(value));
+    BOOST_TEST(value == 1);
+    producer.join();
+    BOOST_TEST(pushed);
+    BOOST_TEST(ring.pop(value));
+    BOOST_TEST(value == 2);
+}
+
+BOOST_AUTO_TEST_CASE(interrupt_wakes_the_consumer)
+{
+    spsc_ring<int> ring(4);
+    int value;
+
+    std::thread interrupter([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ring.interrupt();
+    });
+    BOOST_TEST(!ring.pop(value));
+    interrupter.join();
+
+    // The interruption is consumed, and does not hide the values pushed afterwards.
+    ring.interrupt();
+    ring.try_push(3);
+    BOOST_TEST(ring.pop(value));
+    BOOST_TEST(value == 3);
+}
+
+BOOST_AUTO_TEST_CASE(values_cross_threads_in_order)
+{
+    const int COUNT = 200000;
+
+    spsc_ring<int> ring(8);
+    std::thread producer([&]() {
+        for (int i = 0; i < COUNT; i++) ring.push(int(i));
+    });
+
+    bool ordered = true;
+    int value;
+    for (int i = 0; i < COUNT; i++)
+    {
+        if (!ring.pop(value) || value != i) ordered = false;
+    }
+    producer.join();
+
+    BOOST_TEST(ordered);
+    BOOST_TEST(ring.size() == 0u);
+    BOOST_TEST(ring.high_water_mark() <= 8u);
+}